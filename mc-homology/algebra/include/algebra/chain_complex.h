@@ -3,7 +3,10 @@
 
 #pragma once
 
+#include "algebra/column_reduction.h"
 #include "algebra/matrix_algorithms.h"
+#include "algebra/sparse_matrix.h"
+#include "algebra/sparse_matrix_algorithms.h"
 
 namespace algebra {
 
@@ -26,7 +29,9 @@ constexpr inline SkipCorrectnessCheckT skip_correctness_check {};
 /// (the chain complex condidition).
 ///
 /// \tparam T Class of the coefficients
-template<class T>
+/// \tparam M Class of the boundary matrices, either `Matrix<T>` or
+///         `SparseMatrix<T>`
+template<class T, class M = Matrix<T>>
 class ChainComplex {
 public:
     constexpr ChainComplex() = default;
@@ -36,7 +41,7 @@ public:
     ///
     /// \param boundaries The range containing the boundary opeartors
     template<std::ranges::sized_range R>
-        requires std::convertible_to<std::ranges::range_value_t<R>, Matrix<T>>
+        requires std::convertible_to<std::ranges::range_value_t<R>, M>
     constexpr ChainComplex(R&& boundaries) :
         ChainComplex(skip_correctness_check, std::forward<R>(boundaries)) {
         if (!check_boundary_correctness()) {
@@ -53,10 +58,10 @@ public:
     ///
     /// \param boundaries The range containing the boundary opeartors
     template<std::ranges::sized_range R>
-        requires std::convertible_to<std::ranges::range_value_t<R>, Matrix<T>>
+        requires std::convertible_to<std::ranges::range_value_t<R>, M>
     constexpr ChainComplex(SkipCorrectnessCheckT, R&& boundaries) :
         m_boundaries(
-            std::ranges::to<std::vector<Matrix<T>>>(std::forward<R>(boundaries))
+            std::ranges::to<std::vector<M>>(std::forward<R>(boundaries))
         ) {}
 
     /// \brief Checks, if the boundaries satisfy the chain complex
@@ -91,18 +96,18 @@ public:
     /// \brief Return the boundary operator at dimension `dim`
     ///
     /// \param dim Dimension of the boundary operator
-    constexpr Matrix<T> const& boundary(std::size_t dim) const {
+    constexpr M const& boundary(std::size_t dim) const {
         return m_boundaries.at(dim);
     }
 
     /// \brief Return the vector of boundary operators
-    constexpr std::vector<Matrix<T>> const& boundaries() const noexcept {
+    constexpr std::vector<M> const& boundaries() const noexcept {
         return m_boundaries;
     }
 
 private:
     /// \brief A vector of boundary operators
-    std::vector<Matrix<T>> m_boundaries;
+    std::vector<M> m_boundaries;
 };
 
 /// \brief Homology of a chain complex
@@ -126,8 +131,8 @@ struct Homology {
 
 /// \brief Computes homology of a chain complex with coefficients from
 ///        an euclidean domain
-template<EuclideanDomain T>
-Homology<T> homology(ChainComplex<T> const& chain_complex) {
+template<EuclideanDomain T, class M>
+Homology<T> homology(ChainComplex<T, M> const& chain_complex) {
     namespace rs = std::ranges;
     namespace vs = std::views;
     auto const& boundaries = chain_complex.boundaries();
@@ -159,10 +164,58 @@ Homology<T> homology(ChainComplex<T> const& chain_complex) {
     return homology;
 }
 
+/// \brief Computes homology of a chain complex with sparse boundaries
+///        and coefficients from an euclidean domain
+///
+/// Boundaries are reduced from the highest dimension down with the
+/// column reduction algorithm, pivoting only on units, which costs as
+/// much as the reduction over a field (see
+/// `reduce_columns_over_units`). A boundary reduced this way
+/// contributes no torsion. Only boundaries, whose reduction meets a
+/// non-unit pivot, are transformed into the Smith form to find their
+/// torsion coefficients.
+template<EuclideanDomain T>
+Homology<T>
+homology(ChainComplex<T, SparseMatrix<T>> const& chain_complex) {
+    auto const& boundaries = chain_complex.boundaries();
+    Homology<T> homology;
+    homology.betti_numbers.resize(boundaries.size());
+    homology.torsion.resize(boundaries.size());
+    std::size_t prev_rank = 0;
+    std::vector<T> prev_torsion;
+    std::vector<bool> cleared;
+    for (std::size_t k = boundaries.size(); k > 0; --k) {
+        auto const n = k - 1;
+        auto const& boundary = boundaries[n];
+        std::size_t rank = 0;
+        std::vector<T> torsion;
+        if (auto result = reduce_columns_over_units(boundary, cleared)) {
+            rank = result->rank;
+            cleared = pivot_rows(result->reduced);
+        } else {
+            auto [smith, smith_rank] = smith_form(boundary);
+            rank = smith_rank;
+            for (std::size_t i = 0; i < rank; ++i) {
+                if (smith[i, i].euclidean_function() != 1) {
+                    torsion.push_back(smith[i, i]);
+                }
+            }
+            // pivots of the Smith form don't mark columns of the next
+            // boundary, which reduce to zero
+            cleared.clear();
+        }
+        homology.betti_numbers[n] = boundary.ncols() - rank - prev_rank;
+        homology.torsion[n] = std::move(prev_torsion);
+        prev_rank = rank;
+        prev_torsion = std::move(torsion);
+    }
+    return homology;
+}
+
 /// \brief Computes homology of a chain complex with coefficients from
 ///        a field
-template<Field T>
-Homology<T> homology(ChainComplex<T> const& chain_complex) {
+template<Field T, class M>
+Homology<T> homology(ChainComplex<T, M> const& chain_complex) {
     auto const& boundaries = chain_complex.boundaries();
     Homology<T> homology;
     homology.betti_numbers.resize(boundaries.size());
@@ -179,14 +232,44 @@ Homology<T> homology(ChainComplex<T> const& chain_complex) {
     return homology;
 }
 
+/// \brief Computes homology of a chain complex with sparse boundaries
+///        and coefficients from a field
+///
+/// Boundaries are reduced from the highest dimension down with the
+/// column reduction algorithm. Columns of B_n, which are pivots of
+/// the reduced B_(n+1), are cleared without any reduction, as they
+/// always reduce to zero.
+template<Field T>
+Homology<T>
+homology(ChainComplex<T, SparseMatrix<T>> const& chain_complex) {
+    auto const& boundaries = chain_complex.boundaries();
+    Homology<T> homology;
+    homology.betti_numbers.resize(boundaries.size());
+    homology.torsion.resize(boundaries.size());
+    std::size_t prev_rank = 0;
+    std::vector<bool> cleared;
+    for (std::size_t k = boundaries.size(); k > 0; --k) {
+        auto const n = k - 1;
+        auto const& boundary = boundaries[n];
+        auto [reduced, rank] = reduce_columns(boundary, cleared);
+        auto nullity = boundary.ncols() - rank;
+        homology.betti_numbers[n] = nullity - prev_rank;
+        prev_rank = rank;
+        cleared = pivot_rows(reduced);
+    }
+    return homology;
+}
+
 /// \brief Deduction guide for the ChainComplex
 template<std::ranges::sized_range R>
-ChainComplex(SkipCorrectnessCheckT, R&&)
-    -> ChainComplex<typename std::ranges::range_value_t<R>::value_type>;
+ChainComplex(SkipCorrectnessCheckT, R&&) -> ChainComplex<
+    typename std::ranges::range_value_t<R>::value_type,
+    std::ranges::range_value_t<R>>;
 
 /// \brief Deduction guide for the ChainComplex
 template<std::ranges::sized_range R>
-ChainComplex(R&&)
-    -> ChainComplex<typename std::ranges::range_value_t<R>::value_type>;
+ChainComplex(R&&) -> ChainComplex<
+    typename std::ranges::range_value_t<R>::value_type,
+    std::ranges::range_value_t<R>>;
 
 } // namespace algebra
@@ -0,0 +1,208 @@
+/// \file column_reduction.h
+/// \brief A file containing the standard column reduction algorithm
+
+#pragma once
+
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "algebra/detail/sparse_matrix_utils.h"
+#include "algebra/sparse_matrix.h"
+
+namespace algebra {
+
+/// \brief Reduces columns of a sparse matrix in place
+///
+/// Performs the standard left-to-right column reduction: the lowest
+/// non-zero coefficient of every column (its pivot) is eliminated by
+/// adding an earlier column with the same pivot, until the column is
+/// zero or its pivot is unique. Earlier columns are found in constant
+/// time through a pivot-to-column lookup table, and the inverse of every
+/// pivot is computed once, when its column claims it, so eliminations
+/// don't divide. The number of non-zero reduced columns is the rank of
+/// the matrix.
+///
+/// Columns marked in `cleared` are known to reduce to zero, so they
+/// are zeroed without any reduction. For a chain complex the pivots of
+/// the reduced B_(n+1) mark such columns of B_n (see `pivot_rows`).
+///
+/// \param[inout] matrix Matrix to be reduced
+/// \param cleared Columns known to reduce to zero, may be empty
+///
+/// \return The rank of the matrix
+template<Field T>
+constexpr std::size_t reduce_columns(
+    std::in_place_t,
+    SparseMatrix<T>& matrix,
+    std::vector<bool> const& cleared = {}
+) {
+    constexpr auto none = std::numeric_limits<std::size_t>::max();
+    auto const nrows = matrix.nrows();
+    auto columns = std::move(matrix).columns();
+    std::vector<std::size_t> column_with_pivot(nrows, none);
+    std::vector<T> pivot_inverse(nrows);
+    std::vector<SparseEntry<T>> buffer;
+    std::size_t rank = 0;
+    for (std::size_t j = 0; j < columns.size(); ++j) {
+        auto& column = columns[j];
+        if (j < cleared.size() && cleared[j]) {
+            column.clear();
+            continue;
+        }
+        while (!column.empty()) {
+            auto const pivot = column.back().row;
+            if (column_with_pivot[pivot] == none) {
+                column_with_pivot[pivot] = j;
+                pivot_inverse[pivot] = T::one() / column.back().value;
+                ++rank;
+                break;
+            }
+            auto const& other = columns[column_with_pivot[pivot]];
+            auto mult = -(column.back().value * pivot_inverse[pivot]);
+            detail::sparse_column_add(column, mult, other, buffer);
+        }
+    }
+    matrix = SparseMatrix<T>(std::move(columns), nrows);
+    return rank;
+}
+
+/// \brief Result struct for the column reduction algorithm
+template<class T>
+struct ColumnReductionResult {
+    /// \brief Column reduced matrix
+    SparseMatrix<T> reduced = {};
+
+    /// \brief Rank of the matrix
+    std::size_t rank = 0;
+};
+
+/// \brief Reduces columns of a sparse matrix
+///
+/// Performs the standard column reduction described in the in place
+/// overload.
+///
+/// \param matrix Matrix to be reduced
+/// \param cleared Columns known to reduce to zero, may be empty
+///
+/// \return A struct containing two fields
+/// 1. reduced The reduced matrix
+/// 2. rank The rank of the matrix
+template<Field T>
+constexpr ColumnReductionResult<T>
+reduce_columns(SparseMatrix<T> matrix, std::vector<bool> const& cleared = {}) {
+    auto rank = reduce_columns(std::in_place, matrix, cleared);
+    return ColumnReductionResult<T> {
+        .reduced = std::move(matrix),
+        .rank = rank
+    };
+}
+
+/// \brief Reduces columns of a sparse matrix over an euclidean domain
+///        in place, as long as every pivot is a unit
+///
+/// Performs the standard column reduction described in
+/// `reduce_columns`. Adding a multiple of a column with a unit pivot
+/// doesn't need any division, so the reduction is exact over the
+/// domain. If it completes, the reduced matrix is the original one
+/// multiplied by a unimodular matrix and its pivots form a triangular
+/// submatrix with units on the diagonal, so every invariant factor of
+/// the original matrix is a unit. Such a matrix contributes no torsion
+/// to homology and its rank costs as much as over a field.
+///
+/// The reduction stops at the first column, whose pivot is not a unit.
+///
+/// \param[inout] matrix Matrix to be reduced, unspecified if the
+///               reduction stops
+/// \param cleared Columns known to reduce to zero, may be empty
+///
+/// \return The rank of the matrix, or nullopt if a non-unit pivot was
+///         found
+template<EuclideanDomain T>
+constexpr std::optional<std::size_t> reduce_columns_over_units(
+    std::in_place_t,
+    SparseMatrix<T>& matrix,
+    std::vector<bool> const& cleared = {}
+) {
+    constexpr auto none = std::numeric_limits<std::size_t>::max();
+    auto const is_unit = [unit = T::one().euclidean_function()](T const& x) {
+        return x != T::zero() && x.euclidean_function() == unit;
+    };
+    auto const nrows = matrix.nrows();
+    auto columns = std::move(matrix).columns();
+    std::vector<std::size_t> column_with_pivot(nrows, none);
+    // inverses of the pivots, so that every multiplier is exact
+    std::vector<T> pivot_inverse(nrows);
+    std::vector<SparseEntry<T>> buffer;
+    std::size_t rank = 0;
+    for (std::size_t j = 0; j < columns.size(); ++j) {
+        auto& column = columns[j];
+        if (j < cleared.size() && cleared[j]) {
+            column.clear();
+            continue;
+        }
+        while (!column.empty()) {
+            auto const pivot = column.back().row;
+            if (column_with_pivot[pivot] == none) {
+                if (!is_unit(column.back().value)) {
+                    return std::nullopt;
+                }
+                column_with_pivot[pivot] = j;
+                pivot_inverse[pivot] =
+                    divide(T::one(), column.back().value).quotient;
+                ++rank;
+                break;
+            }
+            auto const& other = columns[column_with_pivot[pivot]];
+            auto mult = -(column.back().value * pivot_inverse[pivot]);
+            detail::sparse_column_add(column, mult, other, buffer);
+        }
+    }
+    matrix = SparseMatrix<T>(std::move(columns), nrows);
+    return rank;
+}
+
+/// \brief Reduces columns of a sparse matrix over an euclidean domain,
+///        as long as every pivot is a unit
+///
+/// Performs the column reduction described in the in place overload.
+///
+/// \param matrix Matrix to be reduced
+/// \param cleared Columns known to reduce to zero, may be empty
+///
+/// \return The reduced matrix and its rank, or nullopt if a non-unit
+///         pivot was found
+template<EuclideanDomain T>
+constexpr std::optional<ColumnReductionResult<T>> reduce_columns_over_units(
+    SparseMatrix<T> matrix,
+    std::vector<bool> const& cleared = {}
+) {
+    auto rank = reduce_columns_over_units(std::in_place, matrix, cleared);
+    if (!rank) {
+        return std::nullopt;
+    }
+    return ColumnReductionResult<T> {
+        .reduced = std::move(matrix),
+        .rank = *rank
+    };
+}
+
+/// \brief Marks rows, which are pivots of a column reduced matrix
+///
+/// \param reduced Matrix returned by `reduce_columns`
+///
+/// \return A vector with true for every row, that is the lowest
+///         non-zero coefficient of some column
+template<class T>
+constexpr std::vector<bool> pivot_rows(SparseMatrix<T> const& reduced) {
+    std::vector<bool> pivots(reduced.nrows(), false);
+    for (auto const& column : reduced.columns()) {
+        if (!column.empty()) {
+            pivots[column.back().row] = true;
+        }
+    }
+    return pivots;
+}
+
+} // namespace algebra
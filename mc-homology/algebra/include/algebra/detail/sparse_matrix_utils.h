@@ -0,0 +1,63 @@
+#pragma once
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "algebra/sparse_matrix.h"
+
+namespace algebra {
+namespace detail {
+
+struct IgnoreInsertedRow {
+    constexpr void operator()(std::size_t) const noexcept {}
+};
+
+template<class T>
+constexpr SparseEntry<T> const*
+find_sparse_entry(std::vector<SparseEntry<T>> const& column, std::size_t row) {
+    auto it =
+        std::ranges::lower_bound(column, row, {}, &SparseEntry<T>::row);
+    if (it == column.end() || it->row != row) {
+        return nullptr;
+    }
+    return std::addressof(*it);
+}
+
+template<CommutativeRing T, class F = IgnoreInsertedRow>
+constexpr void sparse_column_add(
+    std::vector<SparseEntry<T>>& target,
+    T const& mult,
+    std::vector<SparseEntry<T>> const& source,
+    std::vector<SparseEntry<T>>& buffer,
+    F&& on_inserted_row = {}
+) {
+    buffer.clear();
+    buffer.reserve(target.size() + source.size());
+    auto t = target.begin();
+    auto s = source.begin();
+    while (t != target.end() || s != source.end()) {
+        if (s == source.end() || (t != target.end() && t->row < s->row)) {
+            buffer.push_back(std::move(*t));
+            ++t;
+        } else if (t == target.end() || s->row < t->row) {
+            auto value = mult * s->value;
+            if (value != T::zero()) {
+                on_inserted_row(s->row);
+                buffer.push_back({.row = s->row, .value = std::move(value)});
+            }
+            ++s;
+        } else {
+            auto value = t->value + mult * s->value;
+            if (value != T::zero()) {
+                buffer.push_back({.row = t->row, .value = std::move(value)});
+            }
+            ++t;
+            ++s;
+        }
+    }
+    target.swap(buffer);
+}
+
+} // namespace detail
+} // namespace algebra
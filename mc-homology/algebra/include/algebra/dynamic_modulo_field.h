@@ -0,0 +1,301 @@
+/// \file dynamic_modulo_field.h
+/// \brief A file containing implementation of fields of integers mod p,
+///        where p is chosen at runtime
+
+#pragma once
+
+#include <cstdint>
+#include <format>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+#include "algebra/algebraic_concepts.h"
+#include "algebra/number_theory.h"
+
+namespace algebra {
+
+/// \brief Field of integers modulo p, where p is chosen at runtime
+///
+/// A class modeling fields of integers modulo an odd prime p below
+/// 2^63. Unlike `ZModP`, the prime doesn't have to be known at compile
+/// time, so homology can be computed over any prime without
+/// recompiling.
+///
+/// Algebraic concepts require `zero()` and `one()` to be static, so
+/// the modulus is a property of the calling thread rather than of the
+/// values. It is selected with a `Modulus` guard for the lifetime of
+/// the guard. Converting an integer without a guard throws, and mixing
+/// values created under different moduli is undefined.
+///
+/// Values are kept in the Montgomery form x * 2^64 mod p, so a
+/// multiplication costs three 64-bit multiplications and no division.
+class DynamicZModP {
+public:
+    /// \brief A guard selecting the modulus of the calling thread
+    ///
+    /// The previous modulus is restored, when the guard is destroyed,
+    /// so guards may be nested.
+    class Modulus {
+    public:
+        /// \brief Selects the modulus p
+        ///
+        /// Throws std::invalid_argument, if p is not an odd prime
+        /// below 2^63.
+        explicit Modulus(std::uint64_t p) : m_previous(context()) {
+            auto const too_large = p >= std::uint64_t {1} << 63;
+            if (too_large || p % 2 == 0 || !is_prime_u64(p)) [[unlikely]] {
+                throw std::invalid_argument(
+                    "The modulus has to be an odd prime below 2^63"
+                );
+            }
+            auto& current = context();
+            current.p = p;
+            // Newton's iteration doubles the number of correct low
+            // bits, starting from 3 bits correct for any odd p
+            current.p_inverse = p;
+            for (int i = 0; i < 5; ++i) {
+                current.p_inverse *= 2 - p * current.p_inverse;
+            }
+            auto const r = static_cast<std::uint64_t>(
+                (static_cast<detail::uint128>(1) << 64) % p
+            );
+            current.r_squared = static_cast<std::uint64_t>(
+                static_cast<detail::uint128>(r) * r % p
+            );
+            current.one = r;
+        }
+
+        /// \brief Restores the previous modulus
+        ~Modulus() {
+            context() = m_previous;
+        }
+
+        Modulus(Modulus const&) = delete;
+        Modulus& operator=(Modulus const&) = delete;
+
+    private:
+        /// \brief Constants of a modulus used by the arithmetic
+        struct Context {
+            /// \brief The modulus, 0 if none is selected
+            std::uint64_t p = 0;
+            /// \brief Inverse of p mod 2^64
+            std::uint64_t p_inverse = 0;
+            /// \brief 2^128 mod p, converts integers to the Montgomery form
+            std::uint64_t r_squared = 0;
+            /// \brief 2^64 mod p, the Montgomery form of 1
+            std::uint64_t one = 0;
+        };
+
+        /// \brief Context active before the guard was created
+        Context m_previous;
+
+        friend DynamicZModP;
+    };
+
+    /// \brief Returns 0.
+    DynamicZModP() = default;
+
+    /// \brief Returns n mod p.
+    ///
+    /// Throws std::logic_error, if no modulus is selected on the calling
+    /// thread.
+    DynamicZModP(std::int64_t n) {
+        auto const p = context().p;
+        if (p == 0) [[unlikely]] {
+            throw std::logic_error(
+                "Integers mod p created without a selected modulus"
+            );
+        }
+        auto residue = static_cast<std::uint64_t>(n < 0 ? -(n + 1) : n) % p;
+        if (n < 0) {
+            residue = p - 1 - residue;
+        }
+        m_montgomery = multiply(residue, context().r_squared);
+    }
+
+    /// \brief Returns the modulus of the calling thread, or 0 if none
+    ///        is selected.
+    static std::uint64_t p() noexcept {
+        return context().p;
+    }
+
+    /// \brief Returns 0.
+    static DynamicZModP zero() noexcept {
+        return {};
+    }
+
+    /// \brief Returns 1.
+    static DynamicZModP one() noexcept {
+        DynamicZModP x;
+        x.m_montgomery = context().one;
+        return x;
+    }
+
+    /// \brief Returns the representative in [0, p).
+    std::uint64_t value() const noexcept {
+        return reduce(m_montgomery);
+    }
+
+    /// \brief Equality comparison
+    ///
+    /// The Montgomery form is reduced to [0, p), so it is unique.
+    bool operator==(DynamicZModP const&) const = default;
+
+    /// \brief Adds rhs to itself
+    DynamicZModP& operator+=(DynamicZModP rhs) noexcept {
+        // both are below p < 2^63, so the sum doesn't overflow
+        auto const p = context().p;
+        m_montgomery += rhs.m_montgomery;
+        if (m_montgomery >= p) {
+            m_montgomery -= p;
+        }
+        return *this;
+    }
+
+    /// \brief Subtracts rhs from itself
+    DynamicZModP& operator-=(DynamicZModP rhs) noexcept {
+        if (m_montgomery < rhs.m_montgomery) {
+            m_montgomery += context().p;
+        }
+        m_montgomery -= rhs.m_montgomery;
+        return *this;
+    }
+
+    /// \brief Returns a copy of itself
+    DynamicZModP operator+() const noexcept {
+        return *this;
+    }
+
+    /// \brief Returns a negation of itself
+    DynamicZModP operator-() const noexcept {
+        DynamicZModP x;
+        x.m_montgomery = m_montgomery == 0 ? 0 : context().p - m_montgomery;
+        return x;
+    }
+
+    /// \brief Multiplies itself by rhs
+    DynamicZModP& operator*=(DynamicZModP rhs) noexcept {
+        m_montgomery = multiply(m_montgomery, rhs.m_montgomery);
+        return *this;
+    }
+
+    /// \brief Returns the multiplicative inverse
+    ///
+    /// Computed with the extended Euclidean algorithm on the reduced
+    /// value, which takes O(log p) divisions, instead of the 2 log2(p)
+    /// multiplications of x^(p-2). Throws std::domain_error for 0.
+    DynamicZModP inverse() const {
+        if (m_montgomery == 0) [[unlikely]] {
+            throw std::domain_error("Division by 0");
+        }
+        auto const p = context().p;
+        // invariant: r0 = s0 * x and r1 = s1 * x mod p, where
+        // |s0|, |s1| <= p < 2^63
+        std::uint64_t r0 = p;
+        std::uint64_t r1 = value();
+        std::int64_t s0 = 0;
+        std::int64_t s1 = 1;
+        while (r1 != 0) {
+            auto const q = r0 / r1;
+            r0 = std::exchange(r1, r0 - q * r1);
+            s0 = std::exchange(s1, s0 - static_cast<std::int64_t>(q) * s1);
+        }
+        auto const residue = s0 < 0 ? static_cast<std::uint64_t>(s0) + p
+                                    : static_cast<std::uint64_t>(s0);
+        DynamicZModP x;
+        x.m_montgomery = multiply(residue, context().r_squared);
+        return x;
+    }
+
+    /// \brief Euclidean function for a field
+    ///
+    /// Euclidean function for fields is constantly equal to 1.
+    int euclidean_function() const noexcept {
+        return 1;
+    }
+
+    /// \brief Divides itself by rhs
+    DynamicZModP& operator/=(DynamicZModP rhs) {
+        return *this *= rhs.inverse();
+    }
+
+private:
+    /// \brief Returns the modulus of the calling thread
+    static Modulus::Context& context() noexcept {
+        thread_local Modulus::Context context;
+        return context;
+    }
+
+    /// \brief Montgomery reduction
+    ///
+    /// \return t / 2^64 mod p, reduced to [0, p), for t < p * 2^64
+    static std::uint64_t reduce(detail::uint128 t) noexcept {
+        auto const& current = context();
+        // m * p agrees with t on the low 64 bits, so t - m * p is
+        // divisible by 2^64 and the difference of high halves is exact
+        auto const m = static_cast<std::uint64_t>(t) * current.p_inverse;
+        auto const mp_high = static_cast<std::uint64_t>(
+            static_cast<detail::uint128>(m) * current.p >> 64
+        );
+        auto const t_high = static_cast<std::uint64_t>(t >> 64);
+        return t_high < mp_high ? t_high - mp_high + current.p
+                                : t_high - mp_high;
+    }
+
+    /// \brief Montgomery multiplication
+    ///
+    /// \return a * b / 2^64 mod p
+    static std::uint64_t multiply(std::uint64_t a, std::uint64_t b) noexcept {
+        return reduce(static_cast<detail::uint128>(a) * b);
+    }
+
+    /// \brief Montgomery form of the integer
+    std::uint64_t m_montgomery = 0;
+};
+
+/// \brief Adds two integers mod p
+inline DynamicZModP operator+(DynamicZModP lhs, DynamicZModP rhs) noexcept {
+    return lhs += rhs;
+}
+
+/// \brief Subtracts two integers mod p
+inline DynamicZModP operator-(DynamicZModP lhs, DynamicZModP rhs) noexcept {
+    return lhs -= rhs;
+}
+
+/// \brief Multiplies two integers mod p
+inline DynamicZModP operator*(DynamicZModP lhs, DynamicZModP rhs) noexcept {
+    return lhs *= rhs;
+}
+
+/// \brief Divides two integers mod p
+inline DynamicZModP operator/(DynamicZModP lhs, DynamicZModP rhs) {
+    return lhs /= rhs;
+}
+
+/// \brief Outputs an integer mod p to a stream
+inline std::ostream& operator<<(std::ostream& output, DynamicZModP x) {
+    return output << x.value();
+}
+
+/// \brief A marker that multiplying integers mod p is commutative
+template<>
+constexpr inline bool is_commutative_v<DynamicZModP> = true;
+
+} // namespace algebra
+
+/// \brief Formatter for DynamicZModP type
+///
+/// Allows use of `std::format` with the `DynamicZModP` type. The format
+/// syntax is the same, as in the case of `std::uint64_t`.
+template<>
+struct std::formatter<algebra::DynamicZModP>:
+    public std::formatter<std::uint64_t> {
+    /// \brief Formats an integer mod p
+    template<class FmtContext>
+    FmtContext::iterator
+    format(algebra::DynamicZModP x, FmtContext& ctx) const {
+        return std::formatter<std::uint64_t>::format(x.value(), ctx);
+    }
+};
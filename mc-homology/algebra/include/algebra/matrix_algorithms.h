@@ -3,8 +3,15 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
 #include "algebra/detail/matrix_utils.h"
 #include "algebra/matrix.h"
+#include "algebra/modulo_fields.h"
 
 namespace algebra {
 
@@ -28,8 +35,13 @@ constexpr std::size_t row_echelon_form(std::in_place_t, Matrix<T>& matrix) {
         if (*maybe_i != i) {
             detail::submatrix_swap_rows(matrix, i, *maybe_i, j);
         }
+        // a single division per pivot
+        auto const inverse = T::one() / matrix[i, j];
         for (auto k = i + 1; k < matrix.nrows(); ++k) {
-            auto mult = -matrix[k, j] / matrix[i, j];
+            if (matrix[k, j] == T::zero()) {
+                continue;
+            }
+            auto mult = -matrix[k, j] * inverse;
             detail::submatrix_add_row(matrix, mult, i, k, j);
         }
         ++i;
@@ -37,11 +49,98 @@ constexpr std::size_t row_echelon_form(std::in_place_t, Matrix<T>& matrix) {
     return i;
 }
 
+/// \brief Transforms a matrix over integers mod P into a row echolon
+///        form in place
+///
+/// Overload of the generic algorithm with lazy reduction. Coefficients
+/// are copied into 64-bit accumulators and row additions are plain
+/// multiply-adds without any division. A row is reduced mod P only
+/// when another addition could overflow it or when it becomes a pivot
+/// row, and only the coefficient in the pivot column is reduced to
+/// pick multipliers. The inverse of every pivot comes from the inverse
+/// table of ZModP.
+///
+/// \param[inout] matrix Matrix to be transformed
+///
+/// \return The number of non-zero rows
+template<int P>
+constexpr std::size_t
+row_echelon_form(std::in_place_t, Matrix<ZModP<P>>& matrix) {
+    constexpr std::uint64_t p = P;
+    // a reduced accumulator stays below 2^64 after this many additions
+    // of products of two reduced coefficients
+    constexpr auto max_pending =
+        (std::numeric_limits<std::uint64_t>::max() - (p - 1))
+        / ((p - 1) * (p - 1));
+    auto const nrows = matrix.nrows();
+    auto const ncols = matrix.ncols();
+    std::vector<std::uint64_t> accumulators(matrix.size());
+    std::ranges::transform(
+        matrix.data(),
+        accumulators.begin(),
+        [](ZModP<P> x) {
+            return static_cast<std::uint64_t>(static_cast<int>(x));
+        }
+    );
+    std::vector<std::uint64_t> pending(nrows, 0);
+    auto const row = [&](std::size_t k) {
+        return std::span(accumulators).subspan(k * ncols, ncols);
+    };
+    auto const reduce = [&](std::size_t k) {
+        if (pending[k] != 0) {
+            for (auto& x : row(k)) {
+                x %= p;
+            }
+            pending[k] = 0;
+        }
+    };
+    std::size_t i = 0;
+    for (std::size_t j = 0; j < ncols && i < nrows; ++j) {
+        auto k = i;
+        while (k < nrows && row(k)[j] % p == 0) {
+            ++k;
+        }
+        if (k == nrows) {
+            continue;
+        }
+        if (k != i) {
+            std::ranges::swap_ranges(row(i), row(k));
+            std::ranges::swap(pending[i], pending[k]);
+        }
+        reduce(i);
+        auto const pivot_row = row(i);
+        auto const pivot =
+            ZModP<P>::from_reduced(static_cast<int>(pivot_row[j]));
+        auto const inverse =
+            static_cast<std::uint64_t>(static_cast<int>(pivot.inverse()));
+        for (k = i + 1; k < nrows; ++k) {
+            auto const target = row(k);
+            auto const coefficient = target[j] % p;
+            if (coefficient == 0) {
+                continue;
+            }
+            if (pending[k] == max_pending) {
+                reduce(k);
+            }
+            auto const mult = (p - coefficient) * inverse % p;
+            for (auto l = j; l < ncols; ++l) {
+                target[l] += mult * pivot_row[l];
+            }
+            ++pending[k];
+        }
+        ++i;
+    }
+    std::ranges::transform(accumulators, matrix.begin(), [](std::uint64_t x) {
+        return ZModP<P>::from_reduced(static_cast<int>(x % p));
+    });
+    return i;
+}
+
 /// \brief Result struct for the row echelon algorithm
-template<class T>
+template<class T, class M = Matrix<T>>
 struct RowEchelonFormResult {
     /// \brief Row echelon form of a matrix
-    Matrix<T> row_echelon_form = {};
+    M row_echelon_form = {};
 
     /// \brief Number of non-empty rows of the matrix in row echelon
     ///        form
@@ -61,7 +160,7 @@ struct RowEchelonFormResult {
 template<Field T>
 constexpr RowEchelonFormResult<T> row_echelon_form(Matrix<T> matrix) {
     auto i = row_echelon_form(std::in_place, matrix);
-    return RowEchelonFormResult {
+    return RowEchelonFormResult<T> {
         .row_echelon_form = matrix,
         .non_empty_rows = i
     };
@@ -134,10 +233,10 @@ constexpr std::size_t smith_form(std::in_place_t, Matrix<T>& matrix) {
 }
 
 /// \brief Result struct for the smith algorithm
-template<class T>
+template<class T, class M = Matrix<T>>
 struct SmithFormResult {
     /// \brief Smith form of a matrix
-    Matrix<T> smith_form = {};
+    M smith_form = {};
 
     /// \brief Number of non zero rows or columns
     std::size_t non_empty = 0;
@@ -156,7 +255,7 @@ struct SmithFormResult {
 template<EuclideanDomain T>
 constexpr SmithFormResult<T> smith_form(Matrix<T> matrix) {
     auto k = smith_form(std::in_place, matrix);
-    return SmithFormResult {.smith_form = matrix, .non_empty = k};
+    return SmithFormResult<T> {.smith_form = matrix, .non_empty = k};
 }
 
 } // namespace algebra
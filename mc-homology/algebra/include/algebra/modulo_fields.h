@@ -3,8 +3,11 @@
 
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <format>
 #include <iostream>
+#include <stdexcept>
 
 #include "algebra/algebraic_concepts.h"
 
@@ -15,18 +18,35 @@ namespace algebra {
 /// A class modeling fields of integers modulo P, where P is a prime
 /// number.
 ///
+/// The representation is always reduced to [0, P), so addition and
+/// subtraction correct the result with a single comparison instead of
+/// a division. For P up to `max_inverse_table_modulus` inverses are
+/// looked up in a table computed at compile time.
+///
 /// \param P A prime number
 template<int P>
 class ZModP {
     static_assert(is_prime(P));
 
 public:
+    /// \brief The largest modulus, for which inverses are tabulated
+    constexpr static int max_inverse_table_modulus = 1 << 12;
+
     /// \brief Returns 0.
     constexpr ZModP() = default;
 
     /// \brief Returns n mod P.
     constexpr ZModP(int n) noexcept : m_inner_representation(modulo(n, P)) {}
 
+    /// \brief Returns n, which is already reduced mod P
+    ///
+    /// Skips the reduction, n has to satisfy 0 <= n < P.
+    constexpr static ZModP from_reduced(int n) noexcept {
+        ZModP x;
+        x.m_inner_representation = n;
+        return x;
+    }
+
     /// \brief Returns the modulus P.
     constexpr static int p() noexcept {
         return P;
@@ -52,15 +72,21 @@ public:
 
     /// \brief Adds rhs to itself
     constexpr ZModP& operator+=(ZModP rhs) noexcept {
+        // both are below P, so the sum is below 2P and doesn't overflow
+        // for any P fitting in an int
+        auto const sum = static_cast<unsigned>(m_inner_representation)
+            + static_cast<unsigned>(rhs.m_inner_representation);
         m_inner_representation =
-            modulo(m_inner_representation + rhs.m_inner_representation, P);
+            static_cast<int>(sum >= unsigned {P} ? sum - unsigned {P} : sum);
         return *this;
     }
 
     /// \brief Subtracts rhs from itself
     constexpr ZModP& operator-=(ZModP rhs) noexcept {
-        m_inner_representation =
-            modulo(m_inner_representation - rhs.m_inner_representation, P);
+        m_inner_representation -= rhs.m_inner_representation;
+        if (m_inner_representation < 0) {
+            m_inner_representation += P;
+        }
         return *this;
     }
 
@@ -71,16 +97,34 @@ public:
 
     /// \brief Returns a negation of itself
     constexpr ZModP operator-() const noexcept {
-        return ZModP(modulo(-m_inner_representation, P));
+        return from_reduced(
+            m_inner_representation == 0 ? 0 : P - m_inner_representation
+        );
     }
 
     /// \brief Multiplies itself by rhs
     constexpr ZModP& operator*=(ZModP rhs) noexcept {
-        m_inner_representation =
-            modulo(m_inner_representation * rhs.m_inner_representation, P);
+        m_inner_representation = static_cast<int>(
+            static_cast<std::uint64_t>(m_inner_representation)
+            * static_cast<std::uint64_t>(rhs.m_inner_representation) % P
+        );
         return *this;
     }
 
+    /// \brief Returns the multiplicative inverse
+    ///
+    /// Throws std::domain_error for 0.
+    constexpr ZModP inverse() const {
+        if (m_inner_representation == 0) [[unlikely]] {
+            throw std::domain_error("Division by 0");
+        }
+        if constexpr (P <= max_inverse_table_modulus) {
+            return from_reduced(inverse_table[m_inner_representation]);
+        } else {
+            return ZModP(*inverse_mod(m_inner_representation, P));
+        }
+    }
+
     /// \brief Euclidean function for a field
     ///
     /// Euclidean function for fields is constantly equal to 1.
@@ -90,14 +134,19 @@ public:
 
     /// \brief Divides itself by rhs
     constexpr ZModP& operator/=(ZModP rhs) {
-        auto inverse = inverse_mod(rhs.m_inner_representation, P);
-        if (!inverse) [[unlikely]] {
-            throw std::domain_error("Division by 0");
-        }
-        return *this *= *inverse;
+        return *this *= rhs.inverse();
     }
 
 private:
+    /// \brief Inverses of all non-zero residues, 0 for 0
+    constexpr static auto inverse_table = [] {
+        std::array<int, P <= max_inverse_table_modulus ? P : 0> table {};
+        for (int a = 1; a < static_cast<int>(table.size()); ++a) {
+            table[a] = modulo(*inverse_mod(a, P), P);
+        }
+        return table;
+    }();
+
     /// \brief Inner representation of the integer
     int m_inner_representation = 0;
 };
@@ -150,3 +199,7 @@ struct std::formatter<algebra::ZModP<P>>: public std::formatter<int> {
         return std::formatter<int>::format(static_cast<int>(x), ctx);
     }
 };
+
+// dense matrices over Z3 are bit-sliced; the program itself reduces
+// sparse matrices, so only dense algorithms of the library use them
+#include "algebra/z3_matrix.h"
@@ -5,11 +5,19 @@
 #pragma once
 
 #include <cmath>
+#include <cstdint>
 #include <optional>
 #include <stdexcept>
 
 namespace algebra {
 
+namespace detail {
+
+/// \brief Unsigned 128-bit integer holding products of 64-bit numbers
+__extension__ typedef unsigned __int128 uint128;
+
+} // namespace detail
+
 /// \brief Primality test
 ///
 /// Tests, if a given number is prime, that is divisible only by 1
@@ -30,6 +38,62 @@ constexpr bool is_prime(int n) noexcept {
     return true;
 }
 
+/// \brief Primality test for 64-bit numbers
+///
+/// Trial division is too slow for large numbers, so this function uses
+/// the Miller-Rabin test with the first twelve primes as witnesses,
+/// which is deterministic for all n below 2^64.
+///
+/// \param n Number to test
+///
+/// \return `true`, if the number is prime, otherwise `false`
+constexpr bool is_prime_u64(std::uint64_t n) noexcept {
+    constexpr std::uint64_t witnesses[] = {
+        2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37,
+    };
+    if (n < 2) {
+        return false;
+    }
+    for (auto a : witnesses) {
+        if (n % a == 0) {
+            return n == a;
+        }
+    }
+    auto const multiply = [n](std::uint64_t a, std::uint64_t b) {
+        return static_cast<std::uint64_t>(
+            static_cast<detail::uint128>(a) * b % n
+        );
+    };
+    // n - 1 = d * 2^s with d odd
+    auto d = n - 1;
+    int s = 0;
+    while (d % 2 == 0) {
+        d /= 2;
+        ++s;
+    }
+    for (auto a : witnesses) {
+        std::uint64_t x = 1;
+        for (auto e = d, base = a; e > 0; e /= 2) {
+            if (e % 2 == 1) {
+                x = multiply(x, base);
+            }
+            base = multiply(base, base);
+        }
+        if (x == 1 || x == n - 1) {
+            continue;
+        }
+        bool composite = true;
+        for (int r = 1; r < s && composite; ++r) {
+            x = multiply(x, x);
+            composite = x != n - 1;
+        }
+        if (composite) {
+            return false;
+        }
+    }
+    return true;
+}
+
 /// \brief Result struct for the division operation
 template<class T>
 struct DivResult {
@@ -52,7 +116,9 @@ struct DivResult {
 ///     `remainder`: the remainder
 constexpr DivResult<int> divide(int a, int b) {
     if (b != 0) [[likely]] {
-        auto [q, r] = std::div(a, b);
+        // unlike std::div, usable in constant expressions
+        auto q = a / b;
+        auto r = a % b;
         if (r < 0) {
             q -= b > 0 ? 1 : -1;
             r += b > 0 ? b : -b;
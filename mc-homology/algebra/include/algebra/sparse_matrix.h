@@ -0,0 +1,323 @@
+/// \file sparse_matrix.h
+/// \brief A file containing a sparse matrix implementation
+
+#pragma once
+
+#include <algorithm>
+#include <ranges>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "algebra/algebraic_concepts.h"
+#include "algebra/matrix.h"
+
+namespace algebra {
+
+/// \brief A single non-zero coefficient of a sparse matrix column
+template<class T>
+struct SparseEntry {
+    /// \brief Row of the coefficient
+    std::size_t row = 0;
+    /// \brief Value of the coefficient
+    T value = {};
+
+    /// \brief Equality comparison for entries
+    constexpr bool operator==(SparseEntry const&) const = default;
+};
+
+/// \brief A sparse matrix class
+///
+/// A two-dimensional array representing a mathematical matrix, which
+/// stores only its non-zero coefficients. The coefficients are kept in
+/// a compressed sparse column (CSC) layout: every column is a list of
+/// its non-zero entries sorted increasingly by row. Memory used by the
+/// matrix scales with the number of non-zero coefficients instead of
+/// the product of the number of rows and columns, which makes it
+/// suitable for boundary operators of large complexes.
+template<class T>
+class SparseMatrix {
+public:
+    /// \brief Type of the stored values
+    using value_type = T;
+    /// \brief Size type used by the matrix
+    using size_type = std::size_t;
+    /// \brief Type of a single non-zero coefficient
+    using entry_type = SparseEntry<T>;
+    /// \brief Type of a single column
+    using column_type = std::vector<SparseEntry<T>>;
+
+    constexpr SparseMatrix() = default;
+
+    /// \brief Constructs a zero matrix
+    ///
+    /// \param nrows Number of rows
+    /// \param ncols Number of columns
+    constexpr SparseMatrix(size_type nrows, size_type ncols) :
+        m_columns(ncols),
+        m_nrows {nrows},
+        m_ncols {ncols} {}
+
+    /// \brief Constructs a matrix from its columns
+    ///
+    /// Entries of every column are sorted by row, entries with equal
+    /// rows are summed up and zero coefficients are dropped. Every row
+    /// index has to be smaller than nrows.
+    ///
+    /// \param columns Columns of the matrix
+    /// \param nrows Number of rows
+    constexpr explicit SparseMatrix(
+        std::vector<column_type> columns,
+        size_type nrows
+    )
+        requires AdditiveGroup<T>
+        : m_columns(std::move(columns)),
+          m_nrows {nrows},
+          m_ncols {m_columns.size()} {
+        for (auto& column : m_columns) {
+            normalize(column);
+        }
+    }
+
+    /// \brief Constructs a sparse matrix from a dense one
+    ///
+    /// \param dense Matrix to convert
+    constexpr explicit SparseMatrix(Matrix<T> const& dense)
+        requires AdditiveGroup<T>
+        : SparseMatrix(dense.nrows(), dense.ncols()) {
+        for (size_type j = 0; j < m_ncols; ++j) {
+            for (size_type i = 0; i < m_nrows; ++i) {
+                if (dense[i, j] != T::zero()) {
+                    m_columns[j].push_back({.row = i, .value = dense[i, j]});
+                }
+            }
+        }
+    }
+
+    /// \brief Number of rows
+    constexpr size_type nrows() const noexcept {
+        return m_nrows;
+    }
+
+    /// \brief Number of columns
+    constexpr size_type ncols() const noexcept {
+        return m_ncols;
+    }
+
+    /// \brief Test, if the matrix is empty
+    constexpr bool empty() const noexcept {
+        return m_nrows == 0 || m_ncols == 0;
+    }
+
+    /// \brief Number of stored (non-zero) coefficients
+    constexpr size_type nonzeros() const noexcept {
+        size_type count = 0;
+        for (auto const& column : m_columns) {
+            count += column.size();
+        }
+        return count;
+    }
+
+    /// \brief Equality comparison for matrices
+    constexpr bool operator==(SparseMatrix const&) const = default;
+
+    /// \brief Returns the non-zero entries of column `col`
+    ///
+    /// \param col Accessed column
+    constexpr column_type const& column(size_type col) const {
+        if (col >= m_ncols) [[unlikely]] {
+            throw std::out_of_range("Index out of matrix range");
+        }
+        return m_columns[col];
+    }
+
+    /// \brief Direct access to the underlying columns
+    constexpr std::vector<column_type> const& columns() const& noexcept {
+        return m_columns;
+    }
+
+    /// \brief Moves the underlying columns out of the matrix
+    ///
+    /// The matrix is left empty, with no rows and no columns.
+    constexpr std::vector<column_type> columns() && noexcept {
+        m_nrows = 0;
+        m_ncols = 0;
+        return std::exchange(m_columns, {});
+    }
+
+    /// \brief Access element at row `row` and columns `col`
+    ///
+    /// Returns a copy of the coefficient, since zero coefficients are
+    /// not stored.
+    ///
+    /// \param row Accessed row
+    /// \param col Accessed column
+    constexpr T operator[](size_type row, size_type col) const
+        requires AdditiveGroup<T>
+    {
+        if (row >= m_nrows || col >= m_ncols) [[unlikely]] {
+            throw std::out_of_range("Indices out of matrix range");
+        }
+        auto const& column = m_columns[col];
+        auto it = std::ranges::lower_bound(column, row, {}, &entry_type::row);
+        if (it == column.end() || it->row != row) {
+            return T::zero();
+        }
+        return it->value;
+    }
+
+    /// \brief Access element at row `row` and columns `col`
+    ///
+    /// \param row Accessed row
+    /// \param col Accessed column
+    constexpr T at(size_type row, size_type col) const
+        requires AdditiveGroup<T>
+    {
+        return (*this)[row, col];
+    }
+
+    /// \brief Sets element at row `row` and column `col` to `value`
+    ///
+    /// \param row Modified row
+    /// \param col Modified column
+    /// \param value New value of the coefficient
+    constexpr void set(size_type row, size_type col, T value)
+        requires AdditiveGroup<T>
+    {
+        if (row >= m_nrows || col >= m_ncols) [[unlikely]] {
+            throw std::out_of_range("Indices out of matrix range");
+        }
+        auto& column = m_columns[col];
+        auto it = std::ranges::lower_bound(column, row, {}, &entry_type::row);
+        bool const present = it != column.end() && it->row == row;
+        if (value == T::zero()) {
+            if (present) {
+                column.erase(it);
+            }
+        } else if (present) {
+            it->value = std::move(value);
+        } else {
+            column.insert(it, {.row = row, .value = std::move(value)});
+        }
+    }
+
+    /// \brief The transpose of the matrix
+    constexpr SparseMatrix transpose() const {
+        SparseMatrix transposed(m_ncols, m_nrows);
+        std::vector<size_type> row_sizes(m_nrows, 0);
+        for (auto const& column : m_columns) {
+            for (auto const& entry : column) {
+                ++row_sizes[entry.row];
+            }
+        }
+        for (size_type i = 0; i < m_nrows; ++i) {
+            transposed.m_columns[i].reserve(row_sizes[i]);
+        }
+        for (size_type j = 0; j < m_ncols; ++j) {
+            for (auto const& entry : m_columns[j]) {
+                transposed.m_columns[entry.row].push_back(
+                    {.row = j, .value = entry.value}
+                );
+            }
+        }
+        return transposed;
+    }
+
+    /// \brief Converts the matrix into a dense one
+    constexpr Matrix<T> to_dense() const
+        requires AdditiveGroup<T>
+    {
+        auto dense = Matrix<T>::zero(m_nrows, m_ncols);
+        for (size_type j = 0; j < m_ncols; ++j) {
+            for (auto const& entry : m_columns[j]) {
+                dense[entry.row, j] = entry.value;
+            }
+        }
+        return dense;
+    }
+
+    /// \brief Returns true if matrix is zero, false otherwise
+    constexpr bool is_zero() const noexcept {
+        return std::ranges::all_of(m_columns, &column_type::empty);
+    }
+
+    /// \brief Return a rectangle zero matrix
+    constexpr static SparseMatrix zero(size_type n, size_type m) {
+        return SparseMatrix(n, m);
+    }
+
+    /// \brief Return a square zero matrix
+    constexpr static SparseMatrix zero(size_type n) {
+        return SparseMatrix(n, n);
+    }
+
+    /// \brief Return an identity matrix
+    constexpr static SparseMatrix id(size_type n)
+        requires CommutativeRing<T>
+    {
+        SparseMatrix identity(n, n);
+        for (size_type i = 0; i < n; ++i) {
+            identity.m_columns[i].push_back({.row = i, .value = T::one()});
+        }
+        return identity;
+    }
+
+private:
+    /// \brief Sorts the column, merges repeated rows and removes zeros
+    constexpr void normalize(column_type& column) const
+        requires AdditiveGroup<T>
+    {
+        if (!std::ranges::is_sorted(column, {}, &entry_type::row)) {
+            std::ranges::stable_sort(column, {}, &entry_type::row);
+        }
+        auto out = column.begin();
+        for (auto it = column.begin(); it != column.end();) {
+            auto entry = std::move(*it);
+            for (++it; it != column.end() && it->row == entry.row; ++it) {
+                entry.value += it->value;
+            }
+            if (entry.row >= m_nrows) [[unlikely]] {
+                throw std::out_of_range("Row index out of matrix range");
+            }
+            if (entry.value != T::zero()) {
+                *out++ = std::move(entry);
+            }
+        }
+        column.erase(out, column.end());
+    }
+
+    /// \brief Non-zero coefficients stored by columns
+    std::vector<column_type> m_columns;
+    /// \brief Number of rows
+    size_type m_nrows = 0;
+    /// \brief Number of columns
+    size_type m_ncols = 0;
+};
+
+/// \brief Multiplies two sparse matrices
+///
+/// Multiplies two matrices using the usual matrix multiplication.
+template<Ring T>
+constexpr SparseMatrix<T>
+operator*(SparseMatrix<T> const& lhs, SparseMatrix<T> const& rhs) {
+    using SparseMatrix = SparseMatrix<T>;
+    if (lhs.ncols() != rhs.nrows()) {
+        throw std::domain_error(
+            "The number of columns of lhs is different "
+            "than the number of rows of rhs"
+        );
+    }
+    std::vector<typename SparseMatrix::column_type> columns(rhs.ncols());
+    for (std::size_t j = 0; j < rhs.ncols(); ++j) {
+        for (auto const& [k, rhs_value] : rhs.column(j)) {
+            for (auto const& [i, lhs_value] : lhs.column(k)) {
+                columns[j].push_back(
+                    {.row = i, .value = lhs_value * rhs_value}
+                );
+            }
+        }
+    }
+    return SparseMatrix(std::move(columns), lhs.nrows());
+}
+
+} // namespace algebra
@@ -0,0 +1,221 @@
+/// \file sparse_matrix_algorithms.h
+/// \brief A file containing selected sparse matrix algorithms
+
+#pragma once
+
+#include <limits>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+#include "algebra/detail/sparse_matrix_utils.h"
+#include "algebra/matrix_algorithms.h"
+#include "algebra/sparse_matrix.h"
+
+namespace algebra {
+
+/// \brief Transforms a sparse matrix into a row echelon form in place
+///
+/// Transforms a sparse matrix into a row echelon form in place and
+/// returns the number of non-zero rows. The rows are reduced in the
+/// transposed layout, so every row operation touches only the non-zero
+/// coefficients of the two rows involved.
+///
+/// \param[inout] matrix Matrix to be transformed
+///
+/// \return The number of non-zero rows
+template<Field T>
+constexpr std::size_t
+row_echelon_form(std::in_place_t, SparseMatrix<T>& matrix) {
+    constexpr auto none = std::numeric_limits<std::size_t>::max();
+    auto const nrows = matrix.nrows();
+    auto const ncols = matrix.ncols();
+    // rows[i] stores the coefficients of the i'th row indexed by column
+    auto rows = matrix.transpose().columns();
+    std::vector<std::size_t> row_with_leading_column(ncols, none);
+    std::vector<SparseEntry<T>> buffer;
+    for (std::size_t i = 0; i < nrows; ++i) {
+        auto& row = rows[i];
+        while (!row.empty()) {
+            auto const lead = row.front().row;
+            if (row_with_leading_column[lead] == none) {
+                row_with_leading_column[lead] = i;
+                break;
+            }
+            auto const& pivot_row = rows[row_with_leading_column[lead]];
+            auto mult = -row.front().value / pivot_row.front().value;
+            detail::sparse_column_add(row, mult, pivot_row, buffer);
+        }
+    }
+    std::vector<typename SparseMatrix<T>::column_type> echelon_rows;
+    echelon_rows.reserve(nrows);
+    for (auto i : row_with_leading_column) {
+        if (i != none) {
+            echelon_rows.push_back(std::move(rows[i]));
+        }
+    }
+    auto const non_empty_rows = echelon_rows.size();
+    echelon_rows.resize(nrows);
+    matrix = SparseMatrix<T>(std::move(echelon_rows), ncols).transpose();
+    return non_empty_rows;
+}
+
+/// \brief Transforms a sparse matrix into a row echelon form
+///
+/// Transforms a sparse matrix into a row echelon form and returns
+/// the number of non-zero rows.
+///
+/// \param matrix Matrix to be transformed
+///
+/// \return A struct containing two fields
+/// 1. row_echelon_form The transformed matrix
+/// 2. non_empty_rows the number of non-zero rows
+template<Field T>
+constexpr RowEchelonFormResult<T, SparseMatrix<T>>
+row_echelon_form(SparseMatrix<T> matrix) {
+    auto i = row_echelon_form(std::in_place, matrix);
+    return RowEchelonFormResult<T, SparseMatrix<T>> {
+        .row_echelon_form = std::move(matrix),
+        .non_empty_rows = i
+    };
+}
+
+/// \brief Transforms a sparse matrix into a Smith form in place
+///
+/// Transforms a sparse matrix into a Smith form in place and returns
+/// the smaller of non-zero rows or columns. Pivots, which are units,
+/// are eliminated directly in the sparse layout, each of them
+/// contributing a one to the diagonal. Only the remaining submatrix,
+/// which for boundary operators of cubical complexes is typically
+/// tiny, is converted into a dense matrix and passed to the dense
+/// algorithm.
+///
+/// \param[inout] matrix Matrix to be transformed
+///
+/// \return The number of non-zero rows or columns
+template<EuclideanDomain T>
+constexpr std::size_t smith_form(std::in_place_t, SparseMatrix<T>& matrix) {
+    namespace vs = std::views;
+    constexpr auto none = std::numeric_limits<std::size_t>::max();
+    auto const nrows = matrix.nrows();
+    auto const ncols = matrix.ncols();
+    auto columns = std::move(matrix).columns();
+    auto const is_unit = [unit = T::one().euclidean_function()](T const& x) {
+        return x != T::zero() && x.euclidean_function() == unit;
+    };
+    // columns having a non-zero coefficient in the given row, some of
+    // the indices may become stale after column operations
+    std::vector<std::vector<std::size_t>> row_columns(nrows);
+    for (auto const& [j, column] : columns | vs::enumerate) {
+        for (auto const& entry : column) {
+            row_columns[entry.row].push_back(j);
+        }
+    }
+    std::vector<bool> eliminated(ncols, false);
+    std::vector<SparseEntry<T>> buffer;
+    std::size_t units = 0;
+    for (bool progress = true; progress;) {
+        progress = false;
+        for (std::size_t j = 0; j < ncols; ++j) {
+            if (eliminated[j]) {
+                continue;
+            }
+            auto const& column = columns[j];
+            auto pivot = column.end();
+            for (auto it = column.begin(); it != column.end(); ++it) {
+                if (is_unit(it->value)
+                    && (pivot == column.end()
+                        || row_columns[it->row].size()
+                            < row_columns[pivot->row].size())) {
+                    pivot = it;
+                }
+            }
+            if (pivot == column.end()) {
+                continue;
+            }
+            auto const pivot_row = pivot->row;
+            auto const inverse = divide(T::one(), pivot->value).quotient;
+            for (std::size_t k = 0; k < row_columns[pivot_row].size(); ++k) {
+                auto const c = row_columns[pivot_row][k];
+                if (c == j || eliminated[c]) {
+                    continue;
+                }
+                auto const* entry =
+                    detail::find_sparse_entry(columns[c], pivot_row);
+                if (!entry) {
+                    continue;
+                }
+                auto const mult = -(entry->value * inverse);
+                detail::sparse_column_add(
+                    columns[c],
+                    mult,
+                    column,
+                    buffer,
+                    [&row_columns, c](std::size_t row) {
+                        row_columns[row].push_back(c);
+                    }
+                );
+            }
+            // the pivot row is now zero outside of the pivot, so the
+            // rest of the column can be cleared with row operations
+            row_columns[pivot_row].clear();
+            columns[j].clear();
+            eliminated[j] = true;
+            ++units;
+            progress = true;
+        }
+    }
+
+    std::vector<std::size_t> remaining_columns;
+    std::vector<std::size_t> remaining_row_index(nrows, none);
+    std::size_t remaining_rows = 0;
+    for (std::size_t j = 0; j < ncols; ++j) {
+        if (eliminated[j] || columns[j].empty()) {
+            continue;
+        }
+        remaining_columns.push_back(j);
+        for (auto const& entry : columns[j]) {
+            if (remaining_row_index[entry.row] == none) {
+                remaining_row_index[entry.row] = remaining_rows++;
+            }
+        }
+    }
+    auto rest = Matrix<T>::zero(remaining_rows, remaining_columns.size());
+    for (auto const& [k, j] : remaining_columns | vs::enumerate) {
+        for (auto const& entry : columns[j]) {
+            rest[remaining_row_index[entry.row], k] = entry.value;
+        }
+    }
+    auto const rest_non_empty = smith_form(std::in_place, rest);
+
+    matrix = SparseMatrix<T>(nrows, ncols);
+    for (std::size_t i = 0; i < units; ++i) {
+        matrix.set(i, i, T::one());
+    }
+    for (std::size_t i = 0; i < rest_non_empty; ++i) {
+        matrix.set(units + i, units + i, rest[i, i]);
+    }
+    return units + rest_non_empty;
+}
+
+/// \brief Transforms a sparse matrix into a Smith form
+///
+/// Transforms a sparse matrix into a Smith form and returns
+/// the smaller of non-zero rows or columns
+///
+/// \param matrix Matrix to be transformed
+///
+/// \return A struct containing two fields
+/// 1. smith_form The transformed matrix
+/// 2. non_empty The number of non-zero rows or columns
+template<EuclideanDomain T>
+constexpr SmithFormResult<T, SparseMatrix<T>>
+smith_form(SparseMatrix<T> matrix) {
+    auto k = smith_form(std::in_place, matrix);
+    return SmithFormResult<T, SparseMatrix<T>> {
+        .smith_form = std::move(matrix),
+        .non_empty = k
+    };
+}
+
+} // namespace algebra
@@ -17,6 +17,15 @@ public:
     /// \brief Retur>ns n mod P.
     constexpr ZModP(int n) noexcept : m_inner_representation(modulo(n, 2)) {}
 
+    /// \brief Returns n, which is already reduced mod P
+    ///
+    /// Skips the reduction, n has to be 0 or 1.
+    constexpr static ZModP from_reduced(int n) noexcept {
+        ZModP x;
+        x.m_inner_representation = n != 0;
+        return x;
+    }
+
     /// \brief Returns the modulus P.
     constexpr static int p() noexcept {
         return 2;
@@ -75,6 +84,16 @@ public:
         return 1;
     }
 
+    /// \brief Returns the multiplicative inverse
+    ///
+    /// Throws std::domain_error for 0.
+    constexpr ZModP inverse() const {
+        if (!m_inner_representation) [[unlikely]] {
+            throw std::domain_error("Division by 0");
+        }
+        return *this;
+    }
+
     /// \brief Divides itself by rhs
     constexpr ZModP& operator/=(ZModP rhs) {
         if (!rhs.m_inner_representation) [[unlikely]] {
@@ -92,3 +111,5 @@ private:
 using Z2 = ZModP<2>;
 
 } // namespace algebra
+
+#include "algebra/z2_matrix.h"
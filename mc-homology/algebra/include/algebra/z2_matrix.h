@@ -0,0 +1,648 @@
+/// \file z2_matrix.h
+/// \brief A file containing optimized implementation of matrices over
+///        the Z2 field
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "algebra/matrix.h"
+#include "algebra/z2_field.h"
+
+namespace algebra {
+
+/// \brief Template specialization of the Matrix class for Z2
+///
+/// Coefficients are packed 64 per machine word, every row starting at
+/// a word boundary. Unused bits at the end of a row are always zero.
+/// Row swaps and row additions are performed on whole words, which
+/// makes them 64 times cheaper than coefficient-wise operations and
+/// lets the compiler vectorize them.
+///
+/// Only the dense algorithms of the library use this specialization.
+/// Homology of complexes, including the `--Z2` option of the program,
+/// is computed on `SparseMatrix<Z2>` by `reduce_columns`, which doesn't
+/// benefit from it.
+template<>
+class Matrix<Z2> {
+public:
+    /// \brief Type of the words the coefficients are packed into
+    using word_type = std::uint64_t;
+    /// \brief Underlying storage type
+    using storage_type = std::vector<word_type>;
+    /// \brief Type of the stored values
+    using value_type = Z2;
+    /// \brief Size type used by the underlying storage
+    using size_type = std::size_t;
+    /// \brief Difference type used by the underlying storage
+    using difference_type = std::ptrdiff_t;
+    /// \brief Const reference type to the stored values
+    using const_reference = Z2;
+
+    /// \brief Number of coefficients stored in a single word
+    constexpr static size_type word_bits = 64;
+
+    /// \brief Proxy reference to a single coefficient
+    class reference {
+    public:
+        /// \brief Reads the referenced coefficient
+        constexpr operator Z2() const noexcept {
+            return Z2((*m_word & m_mask) != 0);
+        }
+
+        /// \brief Writes the referenced coefficient
+        constexpr reference& operator=(Z2 value) noexcept {
+            if (value == Z2::one()) {
+                *m_word |= m_mask;
+            } else {
+                *m_word &= ~m_mask;
+            }
+            return *this;
+        }
+
+        /// \brief Copies the coefficient referenced by other
+        constexpr reference& operator=(reference const& other) noexcept {
+            return *this = static_cast<Z2>(other);
+        }
+
+        /// \brief Adds rhs to the referenced coefficient
+        constexpr reference& operator+=(Z2 rhs) noexcept {
+            if (rhs == Z2::one()) {
+                *m_word ^= m_mask;
+            }
+            return *this;
+        }
+
+        /// \brief Subtracts rhs from the referenced coefficient
+        constexpr reference& operator-=(Z2 rhs) noexcept {
+            return *this += rhs;
+        }
+
+        /// \brief Multiplies the referenced coefficient by rhs
+        constexpr reference& operator*=(Z2 rhs) noexcept {
+            return *this = static_cast<Z2>(*this) * rhs;
+        }
+
+        /// \brief Divides the referenced coefficient by rhs
+        constexpr reference& operator/=(Z2 rhs) {
+            return *this = static_cast<Z2>(*this) / rhs;
+        }
+
+        /// \brief Equality comparison of the referenced coefficients
+        friend constexpr bool
+        operator==(reference const& lhs, reference const& rhs) noexcept {
+            return static_cast<Z2>(lhs) == static_cast<Z2>(rhs);
+        }
+
+        /// \brief Equality comparison with a coefficient
+        friend constexpr bool
+        operator==(reference const& lhs, Z2 rhs) noexcept {
+            return static_cast<Z2>(lhs) == rhs;
+        }
+
+        /// \brief Swaps the referenced coefficients
+        friend constexpr void swap(reference lhs, reference rhs) noexcept {
+            Z2 tmp = lhs;
+            lhs = rhs;
+            rhs = tmp;
+        }
+
+    private:
+        friend class Matrix;
+
+        constexpr reference(word_type* word, word_type mask) noexcept :
+            m_word {word},
+            m_mask {mask} {}
+
+        /// \brief Word containing the coefficient
+        word_type* m_word;
+        /// \brief Mask selecting the coefficient in the word
+        word_type m_mask;
+    };
+
+    constexpr Matrix() = default;
+
+    /// \brief Construct a matrix from a range
+    ///
+    /// Create a matrix with coefficients taken from the range and with
+    /// the specified number of rows and columns. Size of the range has
+    /// be equal to the product of nrows and ncols.
+    ///
+    /// \param data Range with the coefficients
+    /// \param nrows Number of rows
+    /// \param ncols Number of colums
+    template<std::ranges::sized_range R>
+        requires std::convertible_to<std::ranges::range_value_t<R>, Z2>
+    constexpr explicit Matrix(R&& data, size_type nrows, size_type ncols) :
+        Matrix(nrows, ncols) {
+        if (std::ranges::size(data) != nrows * ncols) [[unlikely]] {
+            throw std::domain_error(
+                "Size of the array is not equal to the number"
+                " of rows times the number of columns"
+            );
+        }
+        auto const coefficients =
+            std::ranges::to<std::vector<Z2>>(std::forward<R>(data));
+        for (size_type i = 0; i < nrows; ++i) {
+            for (size_type j = 0; j < ncols; ++j) {
+                if (coefficients[i * ncols + j] == Z2::one()) {
+                    m_data[word_index(i, j)] |= bit_mask(j);
+                }
+            }
+        }
+    }
+
+    /// \brief Test, if the matrix is empty
+    constexpr bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    /// \brief Number of elements in the matrix
+    constexpr size_type size() const noexcept {
+        return m_nrows * m_ncols;
+    }
+
+    /// \brief Specialized swap algorithm for the matrix
+    constexpr void swap(Matrix& other) noexcept {
+        namespace rs = std::ranges;
+        m_data.swap(other.m_data);
+        rs::swap(m_nrows, other.m_nrows);
+        rs::swap(m_ncols, other.m_ncols);
+        rs::swap(m_row_words, other.m_row_words);
+    }
+
+    /// \brief Number of rows
+    constexpr size_type nrows() const noexcept {
+        return m_nrows;
+    }
+
+    /// \brief Number of columns
+    constexpr size_type ncols() const noexcept {
+        return m_ncols;
+    }
+
+    /// \brief Number of words used by a single row
+    constexpr size_type row_words() const noexcept {
+        return m_row_words;
+    }
+
+    /// \brief Equality comparison for matrices
+    constexpr bool operator==(Matrix const&) const = default;
+
+    /// \brief Access element at row `row` and columns `col`
+    ///
+    /// \param row Accessed row
+    /// \param col Accessed column
+    constexpr reference operator[](size_type row, size_type col) {
+        if (row >= m_nrows || col >= m_ncols) [[unlikely]] {
+            throw std::out_of_range("Indices out of matrix range");
+        }
+        return reference(&m_data[word_index(row, col)], bit_mask(col));
+    }
+
+    /// \brief Access element at row `row` and columns `col`
+    ///
+    /// \param row Accessed row
+    /// \param col Accessed column
+    constexpr const_reference operator[](size_type row, size_type col) const {
+        if (row >= m_nrows || col >= m_ncols) [[unlikely]] {
+            throw std::out_of_range("Indices out of matrix range");
+        }
+        return Z2((m_data[word_index(row, col)] & bit_mask(col)) != 0);
+    }
+
+    /// \brief Access element at row `row` and columns `col`
+    ///
+    /// \param row Accessed row
+    /// \param col Accessed column
+    constexpr reference at(size_type row, size_type col) {
+        return (*this)[row, col];
+    }
+
+    /// \brief Access element at row `row` and columns `col`
+    ///
+    /// \param row Accessed row
+    /// \param col Accessed column
+    constexpr const_reference at(size_type row, size_type col) const {
+        return (*this)[row, col];
+    }
+
+    /// \brief Direct access to the packed words of the matrix
+    constexpr storage_type const& words() const noexcept {
+        return m_data;
+    }
+
+    /// \brief Packed words of the row `row`
+    ///
+    /// \param row Accessed row
+    constexpr std::span<word_type> row(size_type row) {
+        if (row >= m_nrows) [[unlikely]] {
+            throw std::out_of_range("Index out of matrix range");
+        }
+        return std::span(m_data).subspan(row * m_row_words, m_row_words);
+    }
+
+    /// \brief Packed words of the row `row`
+    ///
+    /// \param row Accessed row
+    constexpr std::span<word_type const> row(size_type row) const {
+        if (row >= m_nrows) [[unlikely]] {
+            throw std::out_of_range("Index out of matrix range");
+        }
+        return std::span(m_data).subspan(row * m_row_words, m_row_words);
+    }
+
+    /// \brief Swaps rows `row1` and `row2` word by word
+    ///
+    /// \param row1 First swapped row
+    /// \param row2 Second swapped row
+    constexpr void swap_rows(size_type row1, size_type row2) {
+        std::ranges::swap_ranges(row(row1), row(row2));
+    }
+
+    /// \brief Adds row `source_row` to row `target_row` word by word
+    ///
+    /// Only the words starting from the one containing column
+    /// `first_col` are updated, the caller guarantees that the
+    /// coefficients of the source row before it are zero.
+    ///
+    /// \param source_row Added row
+    /// \param target_row Modified row
+    /// \param first_col First column, which may be non-zero in the
+    ///        source row
+    constexpr void add_row(
+        size_type source_row,
+        size_type target_row,
+        size_type first_col = 0
+    ) {
+        auto const source = row(source_row);
+        auto const target = row(target_row);
+        for (auto w = first_col / word_bits; w < m_row_words; ++w) {
+            target[w] ^= source[w];
+        }
+    }
+
+    /// \brief The transpose of the matrix
+    constexpr Matrix transpose() const {
+        Matrix transposed(m_ncols, m_nrows);
+        for (size_type i = 0; i < m_nrows; ++i) {
+            for (size_type j = 0; j < m_ncols; ++j) {
+                if (m_data[word_index(i, j)] & bit_mask(j)) {
+                    transposed.m_data[transposed.word_index(j, i)] |=
+                        bit_mask(i);
+                }
+            }
+        }
+        return transposed;
+    }
+
+    /// \brief Adds rhs to itself
+    constexpr Matrix& operator+=(Matrix const& rhs) {
+        if (m_nrows != rhs.m_nrows || m_ncols != rhs.m_ncols) {
+            throw std::domain_error("Adding matrices of different dimensions");
+        }
+        for (size_type w = 0; w < m_data.size(); ++w) {
+            m_data[w] ^= rhs.m_data[w];
+        }
+        return *this;
+    }
+
+    /// \brief Subtracts rhs from itself
+    constexpr Matrix& operator-=(Matrix const& rhs) {
+        if (m_nrows != rhs.m_nrows || m_ncols != rhs.m_ncols) {
+            throw std::domain_error(
+                "Subtracting matrices of different dimensions"
+            );
+        }
+        return *this += rhs;
+    }
+
+    /// \brief Returns a copy of itself
+    constexpr Matrix operator+() const {
+        return *this;
+    }
+
+    /// \brief Returns a negation of itself
+    constexpr Matrix operator-() const {
+        return *this;
+    }
+
+    /// \brief Multiplies itself by rhs
+    ///
+    /// Matrix multiplies itself from the right-hand side by rhs.
+    constexpr Matrix& operator*=(Matrix const& rhs);
+
+    /// \brief Return a square zero matrix
+    constexpr static Matrix zero(size_type n) {
+        return Matrix(n, n);
+    }
+
+    /// \brief Return a rectangle zero matrix
+    constexpr static Matrix zero(size_type n, size_type m) {
+        return Matrix(n, m);
+    }
+
+    /// \brief Returns true if matrix is zero, false otherwise
+    constexpr bool is_zero() const noexcept {
+        return std::ranges::all_of(m_data, [](word_type w) {
+            return w == 0;
+        });
+    }
+
+    /// \brief Return an identity matrix
+    constexpr static Matrix id(size_type n) {
+        Matrix identity(n, n);
+        for (size_type i = 0; i < n; ++i) {
+            identity.m_data[identity.word_index(i, i)] |= bit_mask(i);
+        }
+        return identity;
+    }
+
+private:
+    /// \brief Constructs a zero matrix
+    constexpr Matrix(size_type nrows, size_type ncols) :
+        m_data((ncols + word_bits - 1) / word_bits * nrows, 0),
+        m_nrows {nrows},
+        m_ncols {ncols},
+        m_row_words {(ncols + word_bits - 1) / word_bits} {}
+
+    /// \brief Returns the index of the word containing the element at
+    ///        given coordinates
+    constexpr size_type
+    word_index(size_type row, size_type col) const noexcept {
+        return row * m_row_words + col / word_bits;
+    }
+
+    /// \brief Returns the mask selecting the column in its word
+    constexpr static word_type bit_mask(size_type col) noexcept {
+        return word_type {1} << (col % word_bits);
+    }
+
+    /// \brief Packed coefficients, stored row by row
+    storage_type m_data;
+    /// \brief Number of rows
+    size_type m_nrows = 0;
+    /// \brief Number of columns
+    size_type m_ncols = 0;
+    /// \brief Number of words used by a single row
+    size_type m_row_words = 0;
+};
+
+/// \brief Multiplies two matrices over Z2
+///
+/// For every non-zero coefficient lhs[i, k] the k'th row of rhs is
+/// added to the i'th row of the product word by word.
+constexpr Matrix<Z2> operator*(Matrix<Z2> const& lhs, Matrix<Z2> const& rhs) {
+    using size_type = Matrix<Z2>::size_type;
+    if (lhs.ncols() != rhs.nrows()) {
+        throw std::domain_error(
+            "The number of columns of lhs is different "
+            "than the number of rows of rhs"
+        );
+    }
+    auto product = Matrix<Z2>::zero(lhs.nrows(), rhs.ncols());
+    for (size_type i = 0; i < lhs.nrows(); ++i) {
+        auto const product_row = product.row(i);
+        for (size_type k = 0; k < lhs.ncols(); ++k) {
+            if (lhs[i, k] == Z2::zero()) {
+                continue;
+            }
+            auto const rhs_row = rhs.row(k);
+            for (size_type w = 0; w < product.row_words(); ++w) {
+                product_row[w] ^= rhs_row[w];
+            }
+        }
+    }
+    return product;
+}
+
+constexpr Matrix<Z2>& Matrix<Z2>::operator*=(Matrix const& rhs) {
+    *this = *this * rhs;
+    return *this;
+}
+
+/// \brief Adds two matrices over Z2
+constexpr Matrix<Z2> operator+(Matrix<Z2> lhs, Matrix<Z2> const& rhs) {
+    return lhs += rhs;
+}
+
+/// \brief Subtracts two matrices over Z2
+constexpr Matrix<Z2> operator-(Matrix<Z2> lhs, Matrix<Z2> const& rhs) {
+    return lhs -= rhs;
+}
+
+/// \brief Transforms a matrix over Z2 into a row echolon form in place
+///        with Gaussian elimination
+///
+/// Overload of the generic algorithm, which swaps and adds whole rows
+/// word by word. Since the only non-zero coefficient of Z2 is 1, no
+/// multipliers have to be computed.
+///
+/// \param[inout] matrix Matrix to be transformed
+///
+/// \return The number of non-zero rows
+constexpr std::size_t
+gauss_row_echelon_form(std::in_place_t, Matrix<Z2>& matrix) {
+    std::size_t i = 0;
+    for (std::size_t j = 0; j < matrix.ncols() && i < matrix.nrows(); ++j) {
+        auto const w = j / Matrix<Z2>::word_bits;
+        auto const mask = Matrix<Z2>::word_type {1}
+            << (j % Matrix<Z2>::word_bits);
+        auto const has_pivot = [&](std::size_t k) {
+            return (matrix.row(k)[w] & mask) != 0;
+        };
+        auto k = i;
+        while (k < matrix.nrows() && !has_pivot(k)) {
+            ++k;
+        }
+        if (k == matrix.nrows()) {
+            continue;
+        }
+        if (k != i) {
+            matrix.swap_rows(i, k);
+        }
+        for (k = i + 1; k < matrix.nrows(); ++k) {
+            if (has_pivot(k)) {
+                matrix.add_row(i, k, j);
+            }
+        }
+        ++i;
+    }
+    return i;
+}
+
+namespace detail {
+
+/// \brief Reads consecutive coefficients of a packed row over Z2
+///
+/// \param row Packed words of the row
+/// \param col First read column
+/// \param count Number of read columns, smaller than 64
+///
+/// \return Coefficients of columns `col` to `col + count - 1` as bits
+///         0 to `count - 1`
+constexpr std::uint64_t read_row_bits(
+    std::span<std::uint64_t const> row,
+    std::size_t col,
+    std::size_t count
+) {
+    auto const w = col / 64;
+    auto const shift = col % 64;
+    auto bits = row[w] >> shift;
+    if (shift + count > 64) {
+        bits |= row[w + 1] << (64 - shift);
+    }
+    return bits & ((std::uint64_t {1} << count) - 1);
+}
+
+} // namespace detail
+
+/// \brief Transforms a matrix over Z2 into a row echolon form in place
+///        with the Method of Four Russians
+///
+/// Columns are eliminated in strips of `k`. Pivots of a strip are
+/// found with Gaussian elimination restricted to the strip and reduced
+/// against each other. Then all 2^k sums of the pivot rows are
+/// tabulated in Gray code order, at a single row addition per entry,
+/// and every row below the pivots is cleared with a single addition of
+/// the entry selected by its coefficients in the pivot columns. For an
+/// n x n matrix this takes about n^3 / (64 * k) word operations
+/// instead of n^3 / 64.
+///
+/// \param[inout] matrix Matrix to be transformed
+/// \param k Width of the strips, at most 16, or 0 to choose it from
+///        the number of rows
+///
+/// \return The number of non-zero rows
+constexpr std::size_t m4ri_row_echelon_form(
+    std::in_place_t,
+    Matrix<Z2>& matrix,
+    std::size_t k = 0
+) {
+    using word_type = Matrix<Z2>::word_type;
+    if (k > 16) [[unlikely]] {
+        throw std::invalid_argument("Strips of M4RI are at most 16 wide");
+    }
+    if (k == 0) {
+        // a table of about n^(3/4) rows balances building it against
+        // using it for all n rows
+        k = std::clamp<std::size_t>(
+            static_cast<std::size_t>(std::bit_width(matrix.nrows())) * 3 / 4,
+            1,
+            8
+        );
+    }
+    auto const nrows = matrix.nrows();
+    auto const ncols = matrix.ncols();
+    std::vector<std::size_t> pivot_cols;
+    std::vector<word_type> table;
+    std::size_t r = 0;
+    for (std::size_t c = 0; c < ncols && r < nrows; c += k) {
+        auto const width = std::min(k, ncols - c);
+        auto const strip = [&](std::size_t row) {
+            return detail::read_row_bits(matrix.row(row), c, width);
+        };
+        // Gaussian elimination within the strip, pivot rows are moved
+        // to rows r, r + 1, ... and have zeros in other pivot columns
+        pivot_cols.clear();
+        for (auto j = c; j < c + width && r + pivot_cols.size() < nrows;
+             ++j) {
+            auto const top = r + pivot_cols.size();
+            auto const reduced = [&](std::size_t row) {
+                auto bits = strip(row);
+                for (std::size_t p = 0; p < pivot_cols.size(); ++p) {
+                    if ((bits >> (pivot_cols[p] - c)) & 1) {
+                        bits ^= strip(r + p);
+                    }
+                }
+                return bits;
+            };
+            auto t = top;
+            while (t < nrows && ((reduced(t) >> (j - c)) & 1) == 0) {
+                ++t;
+            }
+            if (t == nrows) {
+                continue;
+            }
+            auto const bits = strip(t);
+            for (std::size_t p = 0; p < pivot_cols.size(); ++p) {
+                if ((bits >> (pivot_cols[p] - c)) & 1) {
+                    matrix.add_row(r + p, t, c);
+                }
+            }
+            if (t != top) {
+                matrix.swap_rows(top, t);
+            }
+            for (std::size_t p = 0; p < pivot_cols.size(); ++p) {
+                if ((strip(r + p) >> (j - c)) & 1) {
+                    matrix.add_row(top, r + p, c);
+                }
+            }
+            pivot_cols.push_back(j);
+        }
+        auto const found = pivot_cols.size();
+        if (found == 0) {
+            continue;
+        }
+        // entry g of the table is the sum of pivot rows p with bit p of g
+        // set, consecutive Gray codes differ by a single pivot row
+        auto const first_word = c / Matrix<Z2>::word_bits;
+        auto const words = matrix.row_words() - first_word;
+        table.assign((std::size_t {1} << found) * words, 0);
+        for (std::size_t i = 1; i < (std::size_t {1} << found); ++i) {
+            auto const gray = i ^ (i >> 1);
+            auto const previous = (i - 1) ^ ((i - 1) >> 1);
+            auto const pivot =
+                r + static_cast<std::size_t>(std::countr_zero(i));
+            auto const source = matrix.row(pivot).subspan(first_word);
+            for (std::size_t w = 0; w < words; ++w) {
+                table[gray * words + w] = table[previous * words + w]
+                    ^ source[w];
+            }
+        }
+        for (auto t = r + found; t < nrows; ++t) {
+            auto const bits = strip(t);
+            std::size_t entry = 0;
+            for (std::size_t p = 0; p < found; ++p) {
+                entry |= ((bits >> (pivot_cols[p] - c)) & 1) << p;
+            }
+            if (entry == 0) {
+                continue;
+            }
+            auto const target = matrix.row(t).subspan(first_word);
+            for (std::size_t w = 0; w < words; ++w) {
+                target[w] ^= table[entry * words + w];
+            }
+        }
+        r += found;
+    }
+    return r;
+}
+
+/// \brief Transforms a matrix over Z2 into a row echolon form in place
+///
+/// Overload of the generic algorithm, which is also used by the
+/// homology of chain complexes over Z2. Matrices with at least 256
+/// rows are transformed with `m4ri_row_echelon_form`, smaller ones
+/// with `gauss_row_echelon_form`.
+///
+/// \param[inout] matrix Matrix to be transformed
+///
+/// \return The number of non-zero rows
+constexpr std::size_t row_echelon_form(std::in_place_t, Matrix<Z2>& matrix) {
+    // below this, building the tables costs more than it saves
+    constexpr std::size_t m4ri_min_rows = 256;
+    if (matrix.nrows() >= m4ri_min_rows) {
+        return m4ri_row_echelon_form(std::in_place, matrix);
+    }
+    return gauss_row_echelon_form(std::in_place, matrix);
+}
+
+} // namespace algebra
@@ -0,0 +1,714 @@
+/// \file z3_matrix.h
+/// \brief A file containing optimized implementation of matrices over
+///        the Z3 field
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "algebra/matrix.h"
+#include "algebra/modulo_fields.h"
+
+namespace algebra {
+
+/// \brief Template specialization of the Matrix class for Z3
+///
+/// Coefficients are bit-sliced: every row is stored as two bit planes
+/// of 64 coefficients per machine word, the first one marking
+/// coefficients equal to 1 and the second one marking coefficients
+/// equal to 2. Both planes of a row start at a word boundary and
+/// unused bits at their ends are always zero.
+///
+/// Row additions are computed 64 coefficients at a time with a fixed
+/// boolean formula on the planes, negation swaps the planes, so row
+/// operations need neither branches nor reductions modulo 3.
+///
+/// Only the dense algorithms of the library use this specialization.
+/// Homology of complexes, including the `--Z3` option of the program,
+/// is computed on `SparseMatrix<ZModP<3>>` by `reduce_columns`, which
+/// doesn't benefit from it.
+template<>
+class Matrix<ZModP<3>> {
+public:
+    /// \brief Type of the words the coefficients are packed into
+    using word_type = std::uint64_t;
+    /// \brief Underlying storage type
+    using storage_type = std::vector<word_type>;
+    /// \brief Type of the stored values
+    using value_type = ZModP<3>;
+    /// \brief Size type used by the underlying storage
+    using size_type = std::size_t;
+    /// \brief Difference type used by the underlying storage
+    using difference_type = std::ptrdiff_t;
+    /// \brief Const reference type to the stored values
+    using const_reference = ZModP<3>;
+
+    /// \brief Number of coefficients stored in a single word
+    constexpr static size_type word_bits = 64;
+
+    /// \brief Proxy reference to a single coefficient
+    class reference {
+    public:
+        /// \brief Reads the referenced coefficient
+        constexpr operator ZModP<3>() const noexcept {
+            return ZModP<3>(
+                ((*m_ones & m_mask) != 0) + 2 * ((*m_twos & m_mask) != 0)
+            );
+        }
+
+        /// \brief Writes the referenced coefficient
+        constexpr reference& operator=(ZModP<3> value) noexcept {
+            *m_ones &= ~m_mask;
+            *m_twos &= ~m_mask;
+            if (value == ZModP<3>(1)) {
+                *m_ones |= m_mask;
+            } else if (value == ZModP<3>(2)) {
+                *m_twos |= m_mask;
+            }
+            return *this;
+        }
+
+        /// \brief Copies the coefficient referenced by other
+        constexpr reference& operator=(reference const& other) noexcept {
+            return *this = static_cast<ZModP<3>>(other);
+        }
+
+        /// \brief Adds rhs to the referenced coefficient
+        constexpr reference& operator+=(ZModP<3> rhs) noexcept {
+            return *this = static_cast<ZModP<3>>(*this) + rhs;
+        }
+
+        /// \brief Subtracts rhs from the referenced coefficient
+        constexpr reference& operator-=(ZModP<3> rhs) noexcept {
+            return *this = static_cast<ZModP<3>>(*this) - rhs;
+        }
+
+        /// \brief Multiplies the referenced coefficient by rhs
+        constexpr reference& operator*=(ZModP<3> rhs) noexcept {
+            return *this = static_cast<ZModP<3>>(*this) * rhs;
+        }
+
+        /// \brief Divides the referenced coefficient by rhs
+        constexpr reference& operator/=(ZModP<3> rhs) {
+            return *this = static_cast<ZModP<3>>(*this) / rhs;
+        }
+
+        /// \brief Equality comparison of the referenced coefficients
+        friend constexpr bool
+        operator==(reference const& lhs, reference const& rhs) noexcept {
+            return static_cast<ZModP<3>>(lhs) == static_cast<ZModP<3>>(rhs);
+        }
+
+        /// \brief Equality comparison with a coefficient
+        friend constexpr bool
+        operator==(reference const& lhs, ZModP<3> rhs) noexcept {
+            return static_cast<ZModP<3>>(lhs) == rhs;
+        }
+
+        /// \brief Swaps the referenced coefficients
+        friend constexpr void swap(reference lhs, reference rhs) noexcept {
+            ZModP<3> tmp = lhs;
+            lhs = rhs;
+            rhs = tmp;
+        }
+
+    private:
+        friend class Matrix;
+
+        constexpr reference(
+            word_type* ones,
+            word_type* twos,
+            word_type mask
+        ) noexcept :
+            m_ones {ones},
+            m_twos {twos},
+            m_mask {mask} {}
+
+        /// \brief Word of the plane of ones containing the coefficient
+        word_type* m_ones;
+        /// \brief Word of the plane of twos containing the coefficient
+        word_type* m_twos;
+        /// \brief Mask selecting the coefficient in the words
+        word_type m_mask;
+    };
+
+    /// \brief Iterator over the coefficients, row by row
+    class const_iterator {
+    public:
+        /// \brief Category of the iterator
+        using iterator_concept = std::forward_iterator_tag;
+        /// \brief Type of the coefficients
+        using value_type = ZModP<3>;
+        /// \brief Type of distances between iterators
+        using difference_type = std::ptrdiff_t;
+
+        constexpr const_iterator() = default;
+
+        /// \brief Reads the current coefficient
+        constexpr ZModP<3> operator*() const {
+            return (*m_matrix)[m_index / m_matrix->m_ncols,
+                               m_index % m_matrix->m_ncols];
+        }
+
+        /// \brief Moves to the next coefficient
+        constexpr const_iterator& operator++() noexcept {
+            ++m_index;
+            return *this;
+        }
+
+        /// \brief Moves to the next coefficient
+        constexpr const_iterator operator++(int) noexcept {
+            auto copy = *this;
+            ++m_index;
+            return copy;
+        }
+
+        /// \brief Equality comparison of positions
+        constexpr bool operator==(const_iterator const& other) const noexcept {
+            return m_index == other.m_index;
+        }
+
+    private:
+        friend class Matrix;
+
+        constexpr const_iterator(Matrix const* matrix, size_type index) :
+            m_matrix {matrix},
+            m_index {index} {}
+
+        /// \brief Iterated matrix
+        Matrix const* m_matrix = nullptr;
+        /// \brief Index of the current coefficient
+        size_type m_index = 0;
+    };
+
+    constexpr Matrix() = default;
+
+    /// \brief Construct a matrix from a range
+    ///
+    /// Create a matrix with coefficients taken from the range and with
+    /// the specified number of rows and columns. Size of the range has
+    /// be equal to the product of nrows and ncols.
+    ///
+    /// \param data Range with the coefficients
+    /// \param nrows Number of rows
+    /// \param ncols Number of colums
+    template<std::ranges::sized_range R>
+        requires std::convertible_to<std::ranges::range_value_t<R>, ZModP<3>>
+    constexpr explicit Matrix(R&& data, size_type nrows, size_type ncols) :
+        Matrix(nrows, ncols) {
+        if (std::ranges::size(data) != nrows * ncols) [[unlikely]] {
+            throw std::domain_error(
+                "Size of the array is not equal to the number"
+                " of rows times the number of columns"
+            );
+        }
+        // coefficients are written straight into the planes, one word
+        // of each plane at a time
+        auto it = std::ranges::begin(data);
+        for (size_type i = 0; i < nrows; ++i) {
+            auto const row_ones = ones(i);
+            auto const row_twos = twos(i);
+            for (size_type j = 0; j < ncols; ++j, ++it) {
+                auto const value = static_cast<int>(ZModP<3>(*it));
+                row_ones[j / word_bits] |= word_type {value == 1}
+                    << j % word_bits;
+                row_twos[j / word_bits] |= word_type {value == 2}
+                    << j % word_bits;
+            }
+        }
+    }
+
+    /// \brief Iterator over the coefficients
+    constexpr const_iterator begin() const noexcept {
+        return const_iterator(this, 0);
+    }
+
+    /// \brief Sentinel for the coefficients iterator
+    constexpr const_iterator end() const noexcept {
+        return const_iterator(this, size());
+    }
+
+    /// \brief Test, if the matrix is empty
+    constexpr bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    /// \brief Number of elements in the matrix
+    constexpr size_type size() const noexcept {
+        return m_nrows * m_ncols;
+    }
+
+    /// \brief Specialized swap algorithm for the matrix
+    constexpr void swap(Matrix& other) noexcept {
+        namespace rs = std::ranges;
+        m_data.swap(other.m_data);
+        rs::swap(m_nrows, other.m_nrows);
+        rs::swap(m_ncols, other.m_ncols);
+        rs::swap(m_row_words, other.m_row_words);
+    }
+
+    /// \brief Number of rows
+    constexpr size_type nrows() const noexcept {
+        return m_nrows;
+    }
+
+    /// \brief Number of columns
+    constexpr size_type ncols() const noexcept {
+        return m_ncols;
+    }
+
+    /// \brief Number of words used by a single plane of a row
+    constexpr size_type row_words() const noexcept {
+        return m_row_words;
+    }
+
+    /// \brief Equality comparison for matrices
+    constexpr bool operator==(Matrix const&) const = default;
+
+    /// \brief Access element at row `row` and columns `col`
+    ///
+    /// \param row Accessed row
+    /// \param col Accessed column
+    constexpr reference operator[](size_type row, size_type col) {
+        if (row >= m_nrows || col >= m_ncols) [[unlikely]] {
+            throw std::out_of_range("Indices out of matrix range");
+        }
+        auto const w = word_index(row, col);
+        return reference(
+            &m_data[w],
+            &m_data[w + m_row_words],
+            bit_mask(col)
+        );
+    }
+
+    /// \brief Access element at row `row` and columns `col`
+    ///
+    /// \param row Accessed row
+    /// \param col Accessed column
+    constexpr const_reference operator[](size_type row, size_type col) const {
+        if (row >= m_nrows || col >= m_ncols) [[unlikely]] {
+            throw std::out_of_range("Indices out of matrix range");
+        }
+        auto const w = word_index(row, col);
+        auto const mask = bit_mask(col);
+        return ZModP<3>(
+            ((m_data[w] & mask) != 0)
+            + 2 * ((m_data[w + m_row_words] & mask) != 0)
+        );
+    }
+
+    /// \brief Access element at row `row` and columns `col`
+    ///
+    /// \param row Accessed row
+    /// \param col Accessed column
+    constexpr reference at(size_type row, size_type col) {
+        return (*this)[row, col];
+    }
+
+    /// \brief Access element at row `row` and columns `col`
+    ///
+    /// \param row Accessed row
+    /// \param col Accessed column
+    constexpr const_reference at(size_type row, size_type col) const {
+        return (*this)[row, col];
+    }
+
+    /// \brief Direct access to the packed words of the matrix
+    constexpr storage_type const& words() const noexcept {
+        return m_data;
+    }
+
+    /// \brief Packed words of the plane of ones of the row `row`
+    ///
+    /// \param row Accessed row
+    constexpr std::span<word_type> ones(size_type row) {
+        return plane(row, 0);
+    }
+
+    /// \brief Packed words of the plane of ones of the row `row`
+    ///
+    /// \param row Accessed row
+    constexpr std::span<word_type const> ones(size_type row) const {
+        return plane(row, 0);
+    }
+
+    /// \brief Packed words of the plane of twos of the row `row`
+    ///
+    /// \param row Accessed row
+    constexpr std::span<word_type> twos(size_type row) {
+        return plane(row, 1);
+    }
+
+    /// \brief Packed words of the plane of twos of the row `row`
+    ///
+    /// \param row Accessed row
+    constexpr std::span<word_type const> twos(size_type row) const {
+        return plane(row, 1);
+    }
+
+    /// \brief Swaps rows `row1` and `row2` word by word
+    ///
+    /// \param row1 First swapped row
+    /// \param row2 Second swapped row
+    constexpr void swap_rows(size_type row1, size_type row2) {
+        std::ranges::swap_ranges(ones(row1), ones(row2));
+        std::ranges::swap_ranges(twos(row1), twos(row2));
+    }
+
+    /// \brief Adds two packed words of coefficients
+    ///
+    /// Computes 64 sums at once with 6 boolean operations.
+    ///
+    /// \return Plane of ones and plane of twos of the sum
+    constexpr static std::pair<word_type, word_type> add_words(
+        word_type lhs_ones,
+        word_type lhs_twos,
+        word_type rhs_ones,
+        word_type rhs_twos
+    ) noexcept {
+        auto const t = (lhs_ones | rhs_twos) ^ (lhs_twos | rhs_ones);
+        return {(lhs_twos | rhs_twos) ^ t, (lhs_ones | rhs_ones) ^ t};
+    }
+
+    /// \brief Adds row `source_row` multiplied by `mult` to row
+    ///        `target_row` word by word
+    ///
+    /// Only the words starting from the one containing column
+    /// `first_col` are updated, the caller guarantees that the
+    /// coefficients of the source row before it are zero.
+    ///
+    /// \param mult Multiplier of the added row
+    /// \param source_row Added row
+    /// \param target_row Modified row
+    /// \param first_col First column, which may be non-zero in the
+    ///        source row
+    constexpr void add_row(
+        ZModP<3> mult,
+        size_type source_row,
+        size_type target_row,
+        size_type first_col = 0
+    ) {
+        if (mult == ZModP<3>::zero()) {
+            return;
+        }
+        // multiplying by 2 = -1 swaps the planes
+        auto const negate = mult != ZModP<3>::one();
+        auto const source_ones = negate ? twos(source_row) : ones(source_row);
+        auto const source_twos = negate ? ones(source_row) : twos(source_row);
+        auto const target_ones = ones(target_row);
+        auto const target_twos = twos(target_row);
+        for (auto w = first_col / word_bits; w < m_row_words; ++w) {
+            auto const [sum_ones, sum_twos] = add_words(
+                target_ones[w],
+                target_twos[w],
+                source_ones[w],
+                source_twos[w]
+            );
+            target_ones[w] = sum_ones;
+            target_twos[w] = sum_twos;
+        }
+    }
+
+    /// \brief Multiplies row `row` by `mult` word by word
+    ///
+    /// \param mult Multiplier
+    /// \param row Modified row
+    constexpr void scale_row(ZModP<3> mult, size_type row) {
+        if (mult == ZModP<3>::zero()) {
+            std::ranges::fill(ones(row), 0);
+            std::ranges::fill(twos(row), 0);
+        } else if (mult != ZModP<3>::one()) {
+            std::ranges::swap_ranges(ones(row), twos(row));
+        }
+    }
+
+    /// \brief The transpose of the matrix
+    ///
+    /// Both planes are scanned word by word and only their set bits are
+    /// visited, so zero coefficients cost nothing beyond their words.
+    constexpr Matrix transpose() const {
+        Matrix transposed(m_ncols, m_nrows);
+        for (size_type i = 0; i < m_nrows; ++i) {
+            for (size_type plane = 0; plane < 2; ++plane) {
+                auto const first = word_index(i, 0) + plane * m_row_words;
+                for (size_type w = 0; w < m_row_words; ++w) {
+                    auto bits = m_data[first + w];
+                    for (; bits != 0; bits &= bits - 1) {
+                        auto const j = w * word_bits
+                            + static_cast<size_type>(std::countr_zero(bits));
+                        transposed.m_data
+                            [transposed.word_index(j, i)
+                             + plane * transposed.m_row_words] |= bit_mask(i);
+                    }
+                }
+            }
+        }
+        return transposed;
+    }
+
+    /// \brief Adds rhs to itself
+    constexpr Matrix& operator+=(Matrix const& rhs) {
+        if (m_nrows != rhs.m_nrows || m_ncols != rhs.m_ncols) {
+            throw std::domain_error("Adding matrices of different dimensions");
+        }
+        for (size_type i = 0; i < m_nrows; ++i) {
+            add_planes(ones(i), twos(i), rhs.ones(i), rhs.twos(i));
+        }
+        return *this;
+    }
+
+    /// \brief Subtracts rhs from itself
+    constexpr Matrix& operator-=(Matrix const& rhs) {
+        if (m_nrows != rhs.m_nrows || m_ncols != rhs.m_ncols) {
+            throw std::domain_error(
+                "Subtracting matrices of different dimensions"
+            );
+        }
+        for (size_type i = 0; i < m_nrows; ++i) {
+            add_planes(ones(i), twos(i), rhs.twos(i), rhs.ones(i));
+        }
+        return *this;
+    }
+
+    /// \brief Returns a copy of itself
+    constexpr Matrix operator+() const {
+        return *this;
+    }
+
+    /// \brief Returns a negation of itself
+    constexpr Matrix operator-() const {
+        auto negated = *this;
+        for (size_type i = 0; i < m_nrows; ++i) {
+            negated.scale_row(ZModP<3>(2), i);
+        }
+        return negated;
+    }
+
+    /// \brief Multiplies itself by rhs
+    ///
+    /// Matrix multiplies itself from the right-hand side by rhs.
+    constexpr Matrix& operator*=(Matrix const& rhs);
+
+    /// \brief Return a square zero matrix
+    constexpr static Matrix zero(size_type n) {
+        return Matrix(n, n);
+    }
+
+    /// \brief Return a rectangle zero matrix
+    constexpr static Matrix zero(size_type n, size_type m) {
+        return Matrix(n, m);
+    }
+
+    /// \brief Returns true if matrix is zero, false otherwise
+    constexpr bool is_zero() const noexcept {
+        return std::ranges::all_of(m_data, [](word_type w) {
+            return w == 0;
+        });
+    }
+
+    /// \brief Return an identity matrix
+    constexpr static Matrix id(size_type n) {
+        Matrix identity(n, n);
+        for (size_type i = 0; i < n; ++i) {
+            identity.m_data[identity.word_index(i, i)] |= bit_mask(i);
+        }
+        return identity;
+    }
+
+private:
+    /// \brief Constructs a zero matrix
+    constexpr Matrix(size_type nrows, size_type ncols) :
+        m_data(2 * ((ncols + word_bits - 1) / word_bits) * nrows, 0),
+        m_nrows {nrows},
+        m_ncols {ncols},
+        m_row_words {(ncols + word_bits - 1) / word_bits} {}
+
+    /// \brief Adds packed planes of a row to packed planes of another
+    ///        row
+    constexpr static void add_planes(
+        std::span<word_type> target_ones,
+        std::span<word_type> target_twos,
+        std::span<word_type const> source_ones,
+        std::span<word_type const> source_twos
+    ) noexcept {
+        for (size_type w = 0; w < target_ones.size(); ++w) {
+            auto const [sum_ones, sum_twos] = add_words(
+                target_ones[w],
+                target_twos[w],
+                source_ones[w],
+                source_twos[w]
+            );
+            target_ones[w] = sum_ones;
+            target_twos[w] = sum_twos;
+        }
+    }
+
+    /// \brief Packed words of a plane of the row `row`
+    ///
+    /// \param row Accessed row
+    /// \param plane 0 for the plane of ones, 1 for the plane of twos
+    constexpr std::span<word_type> plane(size_type row, size_type plane) {
+        if (row >= m_nrows) [[unlikely]] {
+            throw std::out_of_range("Index out of matrix range");
+        }
+        return std::span(m_data).subspan(
+            (2 * row + plane) * m_row_words,
+            m_row_words
+        );
+    }
+
+    /// \brief Packed words of a plane of the row `row`
+    ///
+    /// \param row Accessed row
+    /// \param plane 0 for the plane of ones, 1 for the plane of twos
+    constexpr std::span<word_type const>
+    plane(size_type row, size_type plane) const {
+        if (row >= m_nrows) [[unlikely]] {
+            throw std::out_of_range("Index out of matrix range");
+        }
+        return std::span(m_data).subspan(
+            (2 * row + plane) * m_row_words,
+            m_row_words
+        );
+    }
+
+    /// \brief Returns the index of the word of the plane of ones
+    ///        containing the element at given coordinates
+    constexpr size_type
+    word_index(size_type row, size_type col) const noexcept {
+        return 2 * row * m_row_words + col / word_bits;
+    }
+
+    /// \brief Returns the mask selecting the column in its word
+    constexpr static word_type bit_mask(size_type col) noexcept {
+        return word_type {1} << (col % word_bits);
+    }
+
+    /// \brief Packed coefficients, stored row by row, the plane of
+    ///        ones of a row followed by its plane of twos
+    storage_type m_data;
+    /// \brief Number of rows
+    size_type m_nrows = 0;
+    /// \brief Number of columns
+    size_type m_ncols = 0;
+    /// \brief Number of words used by a single plane of a row
+    size_type m_row_words = 0;
+};
+
+/// \brief Multiplies two matrices over Z3
+///
+/// For every non-zero coefficient lhs[i, k] the k'th row of rhs
+/// multiplied by it is added to the i'th row of the product word by
+/// word.
+constexpr Matrix<ZModP<3>>
+operator*(Matrix<ZModP<3>> const& lhs, Matrix<ZModP<3>> const& rhs) {
+    using Matrix = Matrix<ZModP<3>>;
+    using size_type = Matrix::size_type;
+    if (lhs.ncols() != rhs.nrows()) {
+        throw std::domain_error(
+            "The number of columns of lhs is different "
+            "than the number of rows of rhs"
+        );
+    }
+    auto product = Matrix::zero(lhs.nrows(), rhs.ncols());
+    for (size_type i = 0; i < lhs.nrows(); ++i) {
+        auto const product_ones = product.ones(i);
+        auto const product_twos = product.twos(i);
+        for (size_type k = 0; k < lhs.ncols(); ++k) {
+            auto const mult = lhs[i, k];
+            if (mult == ZModP<3>::zero()) {
+                continue;
+            }
+            // multiplying by 2 = -1 swaps the planes
+            auto const negate = mult != ZModP<3>::one();
+            auto const rhs_ones = negate ? rhs.twos(k) : rhs.ones(k);
+            auto const rhs_twos = negate ? rhs.ones(k) : rhs.twos(k);
+            for (size_type w = 0; w < product.row_words(); ++w) {
+                auto const [sum_ones, sum_twos] = Matrix::add_words(
+                    product_ones[w],
+                    product_twos[w],
+                    rhs_ones[w],
+                    rhs_twos[w]
+                );
+                product_ones[w] = sum_ones;
+                product_twos[w] = sum_twos;
+            }
+        }
+    }
+    return product;
+}
+
+constexpr Matrix<ZModP<3>>&
+Matrix<ZModP<3>>::operator*=(Matrix const& rhs) {
+    *this = *this * rhs;
+    return *this;
+}
+
+/// \brief Adds two matrices over Z3
+constexpr Matrix<ZModP<3>>
+operator+(Matrix<ZModP<3>> lhs, Matrix<ZModP<3>> const& rhs) {
+    return lhs += rhs;
+}
+
+/// \brief Subtracts two matrices over Z3
+constexpr Matrix<ZModP<3>>
+operator-(Matrix<ZModP<3>> lhs, Matrix<ZModP<3>> const& rhs) {
+    return lhs -= rhs;
+}
+
+/// \brief Transforms a matrix over Z3 into a row echolon form in place
+///
+/// Overload of the generic algorithm, which swaps and adds whole rows
+/// word by word. Non-zero coefficients of Z3 are 1 and 2 = -1, so the
+/// multiplier eliminating a coefficient is 1, if it differs from the
+/// pivot, and -1 otherwise.
+///
+/// \param[inout] matrix Matrix to be transformed
+///
+/// \return The number of non-zero rows
+constexpr std::size_t
+row_echelon_form(std::in_place_t, Matrix<ZModP<3>>& matrix) {
+    using Matrix = Matrix<ZModP<3>>;
+    std::size_t i = 0;
+    for (std::size_t j = 0; j < matrix.ncols() && i < matrix.nrows(); ++j) {
+        auto const w = j / Matrix::word_bits;
+        auto const mask = Matrix::word_type {1} << (j % Matrix::word_bits);
+        auto const has_pivot = [&](std::size_t k) {
+            return ((matrix.ones(k)[w] | matrix.twos(k)[w]) & mask) != 0;
+        };
+        auto k = i;
+        while (k < matrix.nrows() && !has_pivot(k)) {
+            ++k;
+        }
+        if (k == matrix.nrows()) {
+            continue;
+        }
+        if (k != i) {
+            matrix.swap_rows(i, k);
+        }
+        auto const pivot_is_one = (matrix.ones(i)[w] & mask) != 0;
+        for (k = i + 1; k < matrix.nrows(); ++k) {
+            if (has_pivot(k)) {
+                auto const is_one = (matrix.ones(k)[w] & mask) != 0;
+                matrix.add_row(
+                    is_one == pivot_is_one ? ZModP<3>(2) : ZModP<3>(1),
+                    i,
+                    k,
+                    j
+                );
+            }
+        }
+        ++i;
+    }
+    return i;
+}
+
+} // namespace algebra
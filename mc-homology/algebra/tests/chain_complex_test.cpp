@@ -8,6 +8,7 @@
 
 #include "algebra/integer.h"
 #include "algebra/matrix.h"
+#include "algebra/sparse_matrix.h"
 #include "algebra/z2_field.h"
 
 using namespace algebra;
@@ -56,6 +57,16 @@ ChainComplex<T> klein_bottle() {
     }};
 }
 
+template<class T>
+ChainComplex<T, SparseMatrix<T>> sparse_klein_bottle() {
+    auto const dense = klein_bottle<T>();
+    std::vector<SparseMatrix<T>> boundaries;
+    for (auto const& boundary : dense.boundaries()) {
+        boundaries.emplace_back(boundary);
+    }
+    return ChainComplex {std::move(boundaries)};
+}
+
 } // namespace
 
 TEST(ChainComplexTest, Points) {
@@ -181,6 +192,54 @@ TEST(ChainComplexTest, KleinBottle) {
     EXPECT_EQ(homology_klein_bottle_z3.torsion, homology_expected_z3.torsion);
 }
 
+TEST(ChainComplexTest, SparseKleinBottle) {
+    auto homology_z = homology(sparse_klein_bottle<Integer>());
+    auto homology_z2 = homology(sparse_klein_bottle<Z2>());
+    auto homology_z3 = homology(sparse_klein_bottle<ZModP<3>>());
+
+    EXPECT_EQ(
+        homology_z.betti_numbers,
+        homology(klein_bottle<Integer>()).betti_numbers
+    );
+    EXPECT_EQ(homology_z.torsion, homology(klein_bottle<Integer>()).torsion);
+    EXPECT_EQ(
+        homology_z2.betti_numbers,
+        homology(klein_bottle<Z2>()).betti_numbers
+    );
+    EXPECT_EQ(
+        homology_z3.betti_numbers,
+        homology(klein_bottle<ZModP<3>>()).betti_numbers
+    );
+}
+
+TEST(ChainComplexTest, SparseTorsionInOneDimension) {
+    // a triangle with a 2-cell attached twice along it, so H_1 = Z/2
+    // clang-format off
+    ChainComplex const dense {std::vector<Matrix<Integer>> {
+        Matrix<Integer>::zero(0, 3),
+        Matrix<Integer>(
+            std::vector<Integer> {-1, -1,  0,
+                                   1,  0, -1,
+                                   0,  1,  1},
+            3, 3),
+        Matrix<Integer>(std::vector<Integer> {2, -2, 2}, 3, 1)
+    }};
+    // clang-format on
+    std::vector<SparseMatrix<Integer>> boundaries;
+    for (auto const& boundary : dense.boundaries()) {
+        boundaries.emplace_back(boundary);
+    }
+    auto const sparse = homology(ChainComplex {std::move(boundaries)});
+
+    EXPECT_EQ(sparse.betti_numbers, (std::vector<std::size_t> {1, 0, 0}));
+    EXPECT_EQ(
+        sparse.torsion,
+        (std::vector<std::vector<Integer>> {{}, {2}, {}})
+    );
+    EXPECT_EQ(sparse.betti_numbers, homology(dense).betti_numbers);
+    EXPECT_EQ(sparse.torsion, homology(dense).torsion);
+}
+
 TEST(ChainComplexTest, BigSimplex) {
     namespace rs = std::ranges;
     namespace vs = std::views;
@@ -0,0 +1,124 @@
+#include "algebra/column_reduction.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "algebra/integer.h"
+#include "algebra/matrix.h"
+#include "algebra/modulo_fields.h"
+#include "algebra/sparse_matrix.h"
+#include "algebra/sparse_matrix_algorithms.h"
+
+using namespace algebra;
+
+namespace {
+
+template<Field T>
+bool has_unique_pivots(SparseMatrix<T> const& reduced) {
+    std::vector<bool> seen(reduced.nrows(), false);
+    for (auto const& column : reduced.columns()) {
+        if (column.empty()) {
+            continue;
+        }
+        if (seen[column.back().row]) {
+            return false;
+        }
+        seen[column.back().row] = true;
+    }
+    return true;
+}
+
+} // namespace
+
+TEST(ColumnReductionTest, Rank) {
+    using Z13 = ZModP<13>;
+    // clang-format off
+    Matrix<Z13> m1(
+        std::vector {2, 0, 3, 2,
+                     1, 5, 3, 0,
+                     3, 5, 6, 2},
+        3, 4);
+    Matrix<Z13> m2(
+        std::vector {0, 1, 1, 0, 0,
+                     1, 0, 0, 1, 0,
+                     0, 0, 1, 0, 4,
+                     1, 1, 0, 0, 7},
+        4, 5);
+    // clang-format on
+    for (auto const& m : {m1, m2, m1.transpose(), m2.transpose()}) {
+        auto [reduced, rank] = reduce_columns(SparseMatrix(m));
+        EXPECT_PRED1(has_unique_pivots<Z13>, reduced);
+        EXPECT_EQ(rank, row_echelon_form(SparseMatrix(m)).non_empty_rows);
+    }
+    EXPECT_EQ(reduce_columns(SparseMatrix<Z13>::id(5)).rank, 5);
+    EXPECT_EQ(reduce_columns(SparseMatrix<Z13>::zero(2, 3)).rank, 0);
+}
+
+TEST(ColumnReductionTest, Clearing) {
+    using Z3 = ZModP<3>;
+    // boundaries of a filled triangle
+    // clang-format off
+    SparseMatrix b1(Matrix<Z3>(
+        std::vector {-1, -1,  0,
+                      1,  0, -1,
+                      0,  1,  1},
+        3, 3));
+    SparseMatrix b2(Matrix<Z3>(
+        std::vector {1,
+                     -1,
+                     1},
+        3, 1));
+    // clang-format on
+    auto [b2_reduced, b2_rank] = reduce_columns(b2);
+    auto cleared = pivot_rows(b2_reduced);
+    EXPECT_EQ(b2_rank, 1);
+    EXPECT_EQ(std::ranges::count(cleared, true), 1);
+
+    auto [b1_reduced, b1_rank] = reduce_columns(b1);
+    auto [b1_cleared, b1_cleared_rank] = reduce_columns(b1, cleared);
+    EXPECT_EQ(b1_rank, 2);
+    EXPECT_EQ(b1_cleared_rank, b1_rank);
+    EXPECT_EQ(pivot_rows(b1_cleared), pivot_rows(b1_reduced));
+}
+
+TEST(ColumnReductionTest, OverUnits) {
+    // boundaries of a filled triangle
+    // clang-format off
+    SparseMatrix b1(Matrix<Integer>(
+        std::vector<Integer> {-1, -1,  0,
+                               1,  0, -1,
+                               0,  1,  1},
+        3, 3));
+    SparseMatrix b2(Matrix<Integer>(
+        std::vector<Integer> {1,
+                              -1,
+                              1},
+        3, 1));
+    // clang-format on
+    auto b2_result = reduce_columns_over_units(b2);
+    ASSERT_TRUE(b2_result.has_value());
+    EXPECT_EQ(b2_result->rank, 1);
+
+    auto b1_result = reduce_columns_over_units(b1);
+    auto b1_cleared =
+        reduce_columns_over_units(b1, pivot_rows(b2_result->reduced));
+    ASSERT_TRUE(b1_result.has_value());
+    ASSERT_TRUE(b1_cleared.has_value());
+    EXPECT_EQ(b1_result->rank, 2);
+    EXPECT_EQ(b1_cleared->rank, 2);
+    EXPECT_EQ(pivot_rows(b1_cleared->reduced), pivot_rows(b1_result->reduced));
+
+    // the cell attached twice along the triangle
+    auto const doubled = SparseMatrix(Matrix<Integer>(
+        std::vector<Integer> {2, -2, 2},
+        3,
+        1
+    ));
+    EXPECT_FALSE(reduce_columns_over_units(doubled).has_value());
+    EXPECT_EQ(
+        reduce_columns_over_units(SparseMatrix<Integer>::id(4))->rank,
+        4
+    );
+}
@@ -0,0 +1,160 @@
+#include "algebra/dynamic_modulo_field.h"
+
+#include <gtest/gtest.h>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <stdexcept>
+#include <vector>
+
+#include "algebra/algebraic_concepts.h"
+#include "algebra/chain_complex.h"
+#include "algebra/modulo_fields.h"
+#include "algebra/sparse_matrix.h"
+
+using namespace algebra;
+
+TEST(DynamicZModPTest, Concepts) {
+    EXPECT_TRUE(AdditiveGroup<DynamicZModP>);
+    EXPECT_TRUE(CommutativeRing<DynamicZModP>);
+    EXPECT_TRUE(Field<DynamicZModP>);
+}
+
+TEST(DynamicZModPTest, AgreesWithZModP) {
+    DynamicZModP::Modulus const modulus(13);
+    using Z13 = ZModP<13>;
+    for (int a = -13; a < 26; ++a) {
+        for (int b = -13; b < 26; ++b) {
+            auto const x = DynamicZModP(a);
+            auto const y = DynamicZModP(b);
+            EXPECT_EQ((x + y).value(), static_cast<int>(Z13(a) + Z13(b)));
+            EXPECT_EQ((x - y).value(), static_cast<int>(Z13(a) - Z13(b)));
+            EXPECT_EQ((x * y).value(), static_cast<int>(Z13(a) * Z13(b)));
+            if (Z13(b) != Z13::zero()) {
+                EXPECT_EQ((x / y).value(), static_cast<int>(Z13(a) / Z13(b)));
+            }
+        }
+        EXPECT_EQ((-DynamicZModP(a)).value(), static_cast<int>(-Z13(a)));
+    }
+}
+
+TEST(DynamicZModPTest, LargePrimes) {
+    for (std::uint64_t p : {2'147'483'647ull, 2'305'843'009'213'693'951ull}) {
+        DynamicZModP::Modulus const modulus(p);
+        EXPECT_EQ(DynamicZModP::p(), p);
+        DynamicZModP const x = -1;
+        EXPECT_EQ(x.value(), p - 1);
+        EXPECT_EQ(x * x, DynamicZModP::one());
+        EXPECT_EQ(x + DynamicZModP::one(), DynamicZModP::zero());
+        DynamicZModP const y = 123'456'789'012;
+        EXPECT_EQ(y * y.inverse(), DynamicZModP::one());
+        EXPECT_EQ(y / y * y, y);
+        EXPECT_EQ(
+            std::format("{}", DynamicZModP(-2)),
+            std::format("{}", p - 2)
+        );
+    }
+    DynamicZModP::Modulus const modulus(7);
+    EXPECT_EQ(DynamicZModP(INT64_MIN), DynamicZModP(INT64_MIN % 7));
+    EXPECT_THROW(DynamicZModP::zero().inverse(), std::domain_error);
+}
+
+TEST(DynamicZModPTest, Modulus) {
+    EXPECT_THROW(DynamicZModP(1), std::logic_error);
+    EXPECT_THROW(DynamicZModP::Modulus(2), std::invalid_argument);
+    EXPECT_THROW(DynamicZModP::Modulus(91), std::invalid_argument);
+    EXPECT_THROW(
+        DynamicZModP::Modulus(9'223'372'036'854'775'837ull),
+        std::invalid_argument
+    );
+    auto const previous = DynamicZModP::p();
+    {
+        DynamicZModP::Modulus const outer(5);
+        {
+            DynamicZModP::Modulus const inner(11);
+            EXPECT_EQ(DynamicZModP::p(), 11);
+            EXPECT_EQ(DynamicZModP(12), DynamicZModP::one());
+        }
+        EXPECT_EQ(DynamicZModP::p(), 5);
+        EXPECT_EQ(DynamicZModP(6), DynamicZModP::one());
+    }
+    EXPECT_EQ(DynamicZModP::p(), previous);
+}
+
+TEST(DynamicZModPTest, Homology) {
+    // a triangle without its interior has the homology of a circle
+    // over every field
+    auto boundary = [] {
+        using E = SparseEntry<DynamicZModP>;
+        std::vector<std::vector<E>> columns = {
+            {{0, -1}, {1, 1}},
+            {{1, -1}, {2, 1}},
+            {{0, -1}, {2, 1}},
+        };
+        return ChainComplex(std::vector {
+            SparseMatrix<DynamicZModP>::zero(0, 3),
+            SparseMatrix<DynamicZModP>(std::move(columns), 3),
+        });
+    };
+    for (std::uint64_t p : {3ull, 1'000'000'007ull}) {
+        DynamicZModP::Modulus const modulus(p);
+        EXPECT_EQ(
+            homology(boundary()).betti_numbers,
+            (std::vector<std::size_t> {1, 1})
+        );
+    }
+}
+
+TEST(DynamicZModPTest, SphereHomology) {
+    // the boundary of a simplex on 10 vertices is a sphere of dimension
+    // 8; every cell is scaled by its own factor, so that coefficients
+    // are not only 1 and -1
+    constexpr int vertices = 10;
+    auto boundary = [] {
+        auto const scale = [](unsigned cell) {
+            return DynamicZModP(cell + 2);
+        };
+        std::vector<std::vector<unsigned>> cells(vertices - 1);
+        std::vector<std::vector<std::size_t>> index(
+            vertices,
+            std::vector<std::size_t>(1u << vertices)
+        );
+        for (unsigned cell = 1; cell + 1 < 1u << vertices; ++cell) {
+            auto const d = std::popcount(cell) - 1;
+            index[d][cell] = cells[d].size();
+            cells[d].push_back(cell);
+        }
+        std::vector boundaries {
+            SparseMatrix<DynamicZModP>::zero(0, cells[0].size())
+        };
+        for (std::size_t d = 1; d < cells.size(); ++d) {
+            using E = SparseEntry<DynamicZModP>;
+            std::vector<std::vector<E>> columns;
+            for (auto const cell : cells[d]) {
+                std::vector<E> column;
+                std::int64_t sign = 1;
+                for (int v = 0; v < vertices; ++v) {
+                    if (cell >> v & 1) {
+                        auto const face = cell & ~(1u << v);
+                        column.push_back(
+                            {index[d - 1][face],
+                             DynamicZModP(sign) * scale(cell) / scale(face)}
+                        );
+                        sign = -sign;
+                    }
+                }
+                columns.push_back(std::move(column));
+            }
+            boundaries.emplace_back(std::move(columns), cells[d - 1].size());
+        }
+        return ChainComplex(std::move(boundaries));
+    };
+    std::vector<std::size_t> expected(vertices - 1);
+    expected.front() = expected.back() = 1;
+    for (std::uint64_t p : {1'000'003ull, 2'305'843'009'213'693'951ull}) {
+        DynamicZModP::Modulus const modulus(p);
+        EXPECT_EQ(homology(boundary()).betti_numbers, expected);
+    }
+}
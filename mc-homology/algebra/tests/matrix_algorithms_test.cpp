@@ -2,35 +2,18 @@
 
 #include <gtest/gtest.h>
 
+#include <vector>
+
 #include "algebra/integer.h"
 #include "algebra/modulo_fields.h"
+#include "test_matrices.h"
 
 using namespace algebra;
+using test::is_row_echelon;
+using test::random_matrix;
 
 namespace {
 
-template<Field T>
-bool is_row_echelon(Matrix<T> const& matrix) {
-    if (matrix.empty()) {
-        return true;
-    }
-    std::size_t last_col = 0;
-    while (last_col < matrix.ncols() && matrix[0, last_col] == T::zero()) {
-        ++last_col;
-    }
-    for (std::size_t row = 1; row < matrix.nrows(); ++row) {
-        std::size_t col = 0;
-        while (col < matrix.ncols() && matrix[row, col] == T::zero()) {
-            ++col;
-        }
-        if (col <= last_col && col != matrix.ncols()) {
-            return false;
-        }
-        last_col = col;
-    }
-    return true;
-}
-
 template<EuclideanDomain T>
 bool is_smith(Matrix<T> const& matrix) {
     if (matrix.empty()) {
@@ -112,6 +95,29 @@ TEST(MatrixAlgorithmsTest, RowEchelon) {
     EXPECT_EQ(m2_row_echelon_result.non_empty_rows, 2);
 }
 
+TEST(MatrixAlgorithmsTest, RowEchelonLazyReduction) {
+    // rows are reduced every few additions for a large modulus
+    constexpr int P = 1'000'000'007;
+    using F = ZModP<P>;
+    auto const matrix = random_matrix<P>(40, 25) * random_matrix<P>(25, 40);
+    auto const [echelon, rank] = row_echelon_form(matrix);
+    EXPECT_PRED1(is_row_echelon<F>, echelon);
+    EXPECT_EQ(rank, 25);
+    // rows of the echelon form span the rows of the matrix
+    auto stacked = Matrix<F>::zero(65, 40);
+    for (std::size_t i = 0; i < 65; ++i) {
+        for (std::size_t j = 0; j < 40; ++j) {
+            stacked[i, j] = i < 25 ? echelon[i, j] : matrix[i - 25, j];
+        }
+    }
+    EXPECT_EQ(row_echelon_form(stacked).non_empty_rows, 25);
+    auto const small = random_matrix<5>(30, 50);
+    EXPECT_EQ(
+        row_echelon_form(small).non_empty_rows,
+        row_echelon_form(small.transpose()).non_empty_rows
+    );
+}
+
 TEST(MatrixAlgorithmsTest, SmithId) {
     using Matrix = Matrix<Integer>;
     Matrix m = Matrix::id(5);
@@ -40,3 +40,21 @@ TEST(ZModPTest, FieldOperations) {
     EXPECT_TRUE(Field<Z7>);
     EXPECT_EQ(x * one / x, one);
 }
+
+TEST(ZModPTest, Inverses) {
+    // tabulated inverses
+    for (int a = 1; a < 13; ++a) {
+        EXPECT_EQ(ZModP<13>(a) * ZModP<13>(a).inverse(), ZModP<13>::one());
+    }
+    // inverses computed with the extended Euclidean algorithm
+    using Big = ZModP<1'000'003>;
+    static_assert(Big::p() > Big::max_inverse_table_modulus);
+    EXPECT_EQ(Big(123'456) * Big(123'456).inverse(), Big::one());
+    EXPECT_EQ(Big(-1) * Big(-1), Big::one());
+    EXPECT_EQ(Big(1'000'002) + Big(5), Big(4));
+    EXPECT_EQ(Big(3) - Big(5), Big(-2));
+    EXPECT_THROW(Z7::zero().inverse(), std::domain_error);
+    EXPECT_THROW(Z7::one() / Z7::zero(), std::domain_error);
+    EXPECT_EQ(-Z7::zero(), Z7::zero());
+    EXPECT_EQ(Z7::from_reduced(6), Z7(-1));
+}
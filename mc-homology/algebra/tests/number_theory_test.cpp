@@ -2,6 +2,7 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdint>
 #include <functional>
 #include <stdexcept>
 
@@ -14,6 +15,18 @@ TEST(NumberTheoryTest, Primes) {
     EXPECT_PRED1(is_prime, 11);
 }
 
+TEST(NumberTheoryTest, LargePrimes) {
+    for (std::uint64_t n = 0; n < 1000; ++n) {
+        EXPECT_EQ(is_prime_u64(n), is_prime(static_cast<int>(n)));
+    }
+    EXPECT_TRUE(is_prime_u64(2'147'483'647));
+    EXPECT_TRUE(is_prime_u64(18'446'744'073'709'551'557ull));
+    // a strong pseudoprime to all prime bases up to 23
+    EXPECT_FALSE(is_prime_u64(3'825'123'056'546'413'051ull));
+    // the square of a prime above the witnesses
+    EXPECT_FALSE(is_prime_u64(1'000'000'007ull * 1'000'000'007ull));
+}
+
 TEST(NumberTheoryTest, Division) {
     auto [q1, r1] = divide(17, 7);
     auto [q2, r2] = divide(-17, 7);
@@ -0,0 +1,83 @@
+#include "algebra/sparse_matrix_algorithms.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "algebra/integer.h"
+#include "algebra/matrix_algorithms.h"
+#include "algebra/modulo_fields.h"
+#include "algebra/sparse_matrix.h"
+
+using namespace algebra;
+
+namespace {
+
+template<Field T>
+bool is_row_echelon(SparseMatrix<T> const& matrix) {
+    auto rows = matrix.transpose();
+    std::size_t last_col = 0;
+    bool zero_rows = false;
+    for (std::size_t row = 0; row < rows.ncols(); ++row) {
+        auto const& entries = rows.column(row);
+        if (entries.empty()) {
+            zero_rows = true;
+            continue;
+        }
+        if (zero_rows || (row > 0 && entries.front().row <= last_col)) {
+            return false;
+        }
+        last_col = entries.front().row;
+    }
+    return true;
+}
+
+} // namespace
+
+TEST(SparseMatrixAlgorithmsTest, RowEchelon) {
+    using Z13 = ZModP<13>;
+    // clang-format off
+    Matrix<Z13> m1(
+        std::vector {2, 0, 3, 2,
+                     1, 5, 3, 0,
+                     3, 5, 6, 2},
+        3, 4);
+    // clang-format on
+    auto m2 = m1.transpose();
+    auto [m1_echelon, m1_rank] = row_echelon_form(SparseMatrix(m1));
+    auto [m2_echelon, m2_rank] = row_echelon_form(SparseMatrix(m2));
+    EXPECT_PRED1(is_row_echelon<Z13>, m1_echelon);
+    EXPECT_PRED1(is_row_echelon<Z13>, m2_echelon);
+    EXPECT_EQ(m1_rank, 2);
+    EXPECT_EQ(m2_rank, 2);
+    EXPECT_EQ(row_echelon_form(SparseMatrix<Z13>::id(4)).non_empty_rows, 4);
+    EXPECT_EQ(row_echelon_form(SparseMatrix<Z13>::zero(3, 2)).non_empty_rows, 0);
+}
+
+TEST(SparseMatrixAlgorithmsTest, Smith) {
+    using Matrix = Matrix<Integer>;
+    // clang-format off
+    Matrix m1(
+        std::vector {2, 0, 3, 2,
+                     1, 5, 3, 0},
+        2, 4);
+    Matrix m2(
+        std::vector {2,  8, -4, 12,
+                     4, 16,  6, 10,
+                     2,  8,  3,  5,
+                     0,  3,  0,  3},
+        4, 4);
+    Matrix m3(
+        std::vector {1, 1, 0,
+                     0, 1, 1,
+                     1, 0, 1},
+        3, 3);
+    // clang-format on
+    for (auto const& m : {m1, m2, m3, m1.transpose(), m2.transpose()}) {
+        auto [dense_smith, dense_non_empty] = smith_form(m);
+        auto [sparse_smith, sparse_non_empty] = smith_form(SparseMatrix(m));
+        EXPECT_EQ(sparse_smith.to_dense(), dense_smith);
+        EXPECT_EQ(sparse_non_empty, dense_non_empty);
+    }
+    EXPECT_EQ(smith_form(SparseMatrix<Integer>::zero(2, 3)).non_empty, 0);
+}
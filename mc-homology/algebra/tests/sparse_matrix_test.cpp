@@ -0,0 +1,92 @@
+#include "algebra/sparse_matrix.h"
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "algebra/integer.h"
+#include "algebra/matrix.h"
+#include "algebra/modulo_fields.h"
+
+using namespace algebra;
+
+TEST(SparseMatrixTest, Creation) {
+    using SparseMatrix = SparseMatrix<Integer>;
+    SparseMatrix m1(
+        std::vector<SparseMatrix::column_type> {
+            {{.row = 2, .value = 3}, {.row = 0, .value = 1}},
+            {},
+            {{.row = 1, .value = 2}, {.row = 1, .value = -2}},
+        },
+        3
+    );
+    EXPECT_EQ(m1.nrows(), 3);
+    EXPECT_EQ(m1.ncols(), 3);
+    EXPECT_EQ(m1.nonzeros(), 2);
+    EXPECT_EQ((m1[0, 0]), 1);
+    EXPECT_EQ((m1[2, 0]), 3);
+    EXPECT_EQ((m1[1, 2]), 0);
+    EXPECT_EQ(m1.column(0).front().row, 0);
+    EXPECT_THROW((m1[3, 0]), std::out_of_range);
+    EXPECT_THROW(
+        SparseMatrix(
+            std::vector<SparseMatrix::column_type> {{{.row = 3, .value = 1}}},
+            3
+        ),
+        std::out_of_range
+    );
+
+    auto m2 = SparseMatrix::zero(2, 4);
+    EXPECT_TRUE(m2.is_zero());
+    EXPECT_EQ(m2.nonzeros(), 0);
+    m2.set(1, 3, 5);
+    m2.set(0, 3, 4);
+    EXPECT_EQ((m2[1, 3]), 5);
+    EXPECT_EQ((m2[0, 3]), 4);
+    m2.set(1, 3, 0);
+    EXPECT_EQ(m2.nonzeros(), 1);
+
+    auto const columns = std::move(m2).columns();
+    EXPECT_EQ(columns.size(), 4);
+    EXPECT_EQ(m2.nrows(), 0);
+    EXPECT_EQ(m2.ncols(), 0);
+    EXPECT_EQ(m2, SparseMatrix {});
+}
+
+TEST(SparseMatrixTest, DenseConversion) {
+    using Z5 = ZModP<5>;
+    // clang-format off
+    Matrix<Z5> dense(
+        std::vector {1, 0, 3,
+                     0, 0, 6},
+        2, 3);
+    // clang-format on
+    SparseMatrix sparse(dense);
+    EXPECT_EQ(sparse.nonzeros(), 3);
+    EXPECT_EQ(sparse.to_dense(), dense);
+    EXPECT_EQ(sparse.transpose().to_dense(), dense.transpose());
+    EXPECT_EQ(SparseMatrix<Z5>::id(3).to_dense(), Matrix<Z5>::id(3));
+}
+
+TEST(SparseMatrixTest, Multiplication) {
+    using Matrix = Matrix<Integer>;
+    // clang-format off
+    Matrix m1(
+        std::vector {1, 2, 3,
+                     4, 5, 6},
+        2, 3);
+    Matrix m2(
+        std::vector {1, 2, 3, 4,
+                     5, 6, 7, 8,
+                     9, 0, 1, 2},
+        3, 4);
+    // clang-format on
+    SparseMatrix s1(m1);
+    SparseMatrix s2(m2);
+    EXPECT_EQ((s1 * s2).to_dense(), m1 * m2);
+    EXPECT_EQ(s1 * SparseMatrix<Integer>::id(3), s1);
+    EXPECT_THROW(s1 * s1, std::domain_error);
+    EXPECT_TRUE((s1 * SparseMatrix<Integer>::zero(3, 2)).is_zero());
+}
@@ -0,0 +1,55 @@
+/// \file test_matrices.h
+/// \brief Random matrices and predicates on matrices shared by tests
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "algebra/algebraic_concepts.h"
+#include "algebra/matrix.h"
+#include "algebra/modulo_fields.h"
+
+namespace algebra::test {
+
+/// \brief Returns a matrix of pseudorandom integers mod P
+///
+/// The generator is seeded with a fixed value, so equal dimensions
+/// always give the same matrix.
+template<int P>
+Matrix<ZModP<P>> random_matrix(std::size_t nrows, std::size_t ncols) {
+    std::vector<ZModP<P>> data;
+    data.reserve(nrows * ncols);
+    std::uint64_t state = 0x9e3779b97f4a7c15;
+    for (std::size_t k = 0; k < nrows * ncols; ++k) {
+        state = state * 6364136223846793005 + 1442695040888963407;
+        data.emplace_back(static_cast<int>((state >> 33) % P));
+    }
+    return Matrix(std::move(data), nrows, ncols);
+}
+
+/// \brief Tests, if the matrix is in a row echelon form
+template<Field T>
+bool is_row_echelon(Matrix<T> const& matrix) {
+    if (matrix.empty()) {
+        return true;
+    }
+    std::size_t last_col = 0;
+    while (last_col < matrix.ncols() && matrix[0, last_col] == T::zero()) {
+        ++last_col;
+    }
+    for (std::size_t row = 1; row < matrix.nrows(); ++row) {
+        std::size_t col = 0;
+        while (col < matrix.ncols() && matrix[row, col] == T::zero()) {
+            ++col;
+        }
+        if (col <= last_col && col != matrix.ncols()) {
+            return false;
+        }
+        last_col = col;
+    }
+    return true;
+}
+
+} // namespace algebra::test
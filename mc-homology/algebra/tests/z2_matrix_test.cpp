@@ -0,0 +1,101 @@
+#include "algebra/z2_matrix.h"
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "algebra/matrix_algorithms.h"
+#include "algebra/sparse_matrix.h"
+#include "algebra/sparse_matrix_algorithms.h"
+#include "algebra/z2_field.h"
+#include "test_matrices.h"
+
+using namespace algebra;
+using test::is_row_echelon;
+using test::random_matrix;
+
+TEST(Z2MatrixTest, Access) {
+    auto matrix = Matrix<Z2>::zero(3, 70);
+    EXPECT_EQ(matrix.row_words(), 2);
+    EXPECT_TRUE(matrix.is_zero());
+    matrix[1, 65] = 1;
+    matrix[2, 3] += 1;
+    matrix[2, 3] += 1;
+    matrix[0, 0] = matrix[1, 65];
+    EXPECT_EQ((matrix[1, 65]), 1);
+    EXPECT_EQ((matrix[2, 3]), 0);
+    EXPECT_EQ((matrix[0, 0]), 1);
+    EXPECT_EQ((std::as_const(matrix)[1, 64]), Z2::zero());
+    EXPECT_THROW((matrix[3, 0]), std::out_of_range);
+    EXPECT_THROW((matrix[0, 70]), std::out_of_range);
+
+    matrix.swap_rows(0, 1);
+    EXPECT_EQ((matrix[0, 65]), 1);
+    EXPECT_EQ((matrix[1, 0]), 1);
+    matrix.add_row(0, 1);
+    EXPECT_EQ((matrix[1, 65]), 1);
+    matrix.add_row(1, 1);
+    EXPECT_TRUE(matrix.row(1)[0] == 0 && matrix.row(1)[1] == 0);
+}
+
+TEST(Z2MatrixTest, Operations) {
+    auto const m1 = random_matrix<2>(5, 67);
+    auto const m2 = random_matrix<2>(67, 3);
+    auto product = m1 * m2;
+    for (std::size_t i = 0; i < product.nrows(); ++i) {
+        for (std::size_t j = 0; j < product.ncols(); ++j) {
+            Z2 expected = 0;
+            for (std::size_t k = 0; k < m1.ncols(); ++k) {
+                expected += m1[i, k] * m2[k, j];
+            }
+            EXPECT_EQ((product[i, j]), expected);
+        }
+    }
+    EXPECT_EQ(m1 * Matrix<Z2>::id(67), m1);
+    EXPECT_TRUE((m1 + m1).is_zero());
+    EXPECT_EQ(m1.transpose().transpose(), m1);
+    EXPECT_EQ((m1.transpose()[66, 4]), (m1[4, 66]));
+    EXPECT_THROW(m1 * m1, std::domain_error);
+}
+
+TEST(Z2MatrixTest, RowEchelon) {
+    for (auto [nrows, ncols] : {std::pair {7, 5}, {40, 130}, {130, 40}}) {
+        auto matrix = random_matrix<2>(nrows, ncols);
+        auto [echelon, rank] = row_echelon_form(matrix);
+        auto sparse_rank = row_echelon_form(SparseMatrix<Z2>(matrix));
+        EXPECT_PRED1(is_row_echelon<Z2>, echelon);
+        EXPECT_EQ(rank, sparse_rank.non_empty_rows);
+        EXPECT_EQ(rank, row_echelon_form(matrix.transpose()).non_empty_rows);
+    }
+    EXPECT_EQ(row_echelon_form(Matrix<Z2>::id(100)).non_empty_rows, 100);
+    EXPECT_EQ(row_echelon_form(Matrix<Z2>::zero(3, 4)).non_empty_rows, 0);
+}
+
+TEST(Z2MatrixTest, M4RI) {
+    // products of random matrices have a rank below the full one
+    auto const low_rank = random_matrix<2>(150, 20) * random_matrix<2>(20, 300);
+    for (auto const& matrix :
+         {random_matrix<2>(7, 5),
+          random_matrix<2>(40, 130),
+          random_matrix<2>(300, 70),
+          low_rank,
+          low_rank.transpose(),
+          Matrix<Z2>::id(70),
+          Matrix<Z2>::zero(9, 65)}) {
+        auto expected = matrix;
+        auto const rank = gauss_row_echelon_form(std::in_place, expected);
+        for (std::size_t k : {0, 1, 3, 5, 8, 16}) {
+            auto echelon = matrix;
+            EXPECT_EQ(m4ri_row_echelon_form(std::in_place, echelon, k), rank);
+            EXPECT_PRED1(is_row_echelon<Z2>, echelon);
+        }
+    }
+    EXPECT_EQ(row_echelon_form(low_rank).non_empty_rows, 20);
+    auto matrix = random_matrix<2>(3, 3);
+    EXPECT_THROW(
+        m4ri_row_echelon_form(std::in_place, matrix, 17),
+        std::invalid_argument
+    );
+}
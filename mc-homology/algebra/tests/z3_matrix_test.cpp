@@ -0,0 +1,120 @@
+#include "algebra/z3_matrix.h"
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "algebra/matrix_algorithms.h"
+#include "algebra/modulo_fields.h"
+#include "algebra/sparse_matrix.h"
+#include "algebra/sparse_matrix_algorithms.h"
+#include "test_matrices.h"
+
+using namespace algebra;
+using test::is_row_echelon;
+using test::random_matrix;
+
+namespace {
+
+using Z3 = ZModP<3>;
+
+} // namespace
+
+TEST(Z3MatrixTest, Access) {
+    auto matrix = Matrix<Z3>::zero(3, 70);
+    EXPECT_EQ(matrix.row_words(), 2);
+    EXPECT_TRUE(matrix.is_zero());
+    matrix[1, 65] = 2;
+    matrix[2, 3] += 2;
+    matrix[2, 3] += 2;
+    matrix[0, 0] = matrix[1, 65];
+    EXPECT_EQ((matrix[1, 65]), 2);
+    EXPECT_EQ((matrix[2, 3]), 1);
+    EXPECT_EQ((matrix[0, 0]), 2);
+    EXPECT_EQ((std::as_const(matrix)[1, 64]), Z3::zero());
+    EXPECT_THROW((matrix[3, 0]), std::out_of_range);
+    EXPECT_THROW((matrix[0, 70]), std::out_of_range);
+
+    matrix.swap_rows(0, 1);
+    EXPECT_EQ((matrix[0, 65]), 2);
+    EXPECT_EQ((matrix[1, 0]), 2);
+    matrix.add_row(1, 0, 1);
+    EXPECT_EQ((matrix[1, 65]), 2);
+    EXPECT_EQ((matrix[1, 0]), 2);
+    matrix.add_row(2, 1, 0);
+    EXPECT_EQ((matrix[0, 0]), 1);
+    EXPECT_EQ((matrix[0, 65]), 0);
+    matrix.scale_row(2, 2);
+    EXPECT_EQ((matrix[2, 3]), 2);
+    matrix.scale_row(0, 2);
+    EXPECT_EQ((matrix[2, 3]), 0);
+}
+
+TEST(Z3MatrixTest, Arithmetic) {
+    // every pair of coefficients
+    std::vector<Z3> lhs;
+    std::vector<Z3> rhs;
+    for (int a = 0; a < 3; ++a) {
+        for (int b = 0; b < 3; ++b) {
+            lhs.emplace_back(a);
+            rhs.emplace_back(b);
+        }
+    }
+    Matrix<Z3> const m1(lhs, 1, 9);
+    Matrix<Z3> const m2(rhs, 1, 9);
+    auto const sum = m1 + m2;
+    auto const difference = m1 - m2;
+    auto const negation = -m1;
+    for (std::size_t j = 0; j < 9; ++j) {
+        EXPECT_EQ((sum[0, j]), lhs[j] + rhs[j]);
+        EXPECT_EQ((difference[0, j]), lhs[j] - rhs[j]);
+        EXPECT_EQ((negation[0, j]), -lhs[j]);
+    }
+}
+
+TEST(Z3MatrixTest, Operations) {
+    auto const m1 = random_matrix<3>(5, 67);
+    auto const m2 = random_matrix<3>(67, 3);
+    auto product = m1 * m2;
+    for (std::size_t i = 0; i < product.nrows(); ++i) {
+        for (std::size_t j = 0; j < product.ncols(); ++j) {
+            Z3 expected = 0;
+            for (std::size_t k = 0; k < m1.ncols(); ++k) {
+                expected += m1[i, k] * m2[k, j];
+            }
+            EXPECT_EQ((product[i, j]), expected);
+        }
+    }
+    EXPECT_EQ(m1 * Matrix<Z3>::id(67), m1);
+    EXPECT_TRUE((m1 - m1).is_zero());
+    EXPECT_TRUE((m1 + m1 + m1).is_zero());
+    EXPECT_EQ(m1.transpose().transpose(), m1);
+    EXPECT_EQ((m1.transpose()[66, 4]), (m1[4, 66]));
+    EXPECT_THROW(m1 * m1, std::domain_error);
+    std::size_t count = 0;
+    for (auto x : m1) {
+        EXPECT_EQ(x, (m1[count / 67, count % 67]));
+        ++count;
+    }
+    EXPECT_EQ(count, m1.size());
+}
+
+TEST(Z3MatrixTest, RowEchelon) {
+    for (auto [nrows, ncols] : {std::pair {7, 5}, {40, 130}, {130, 40}}) {
+        auto matrix = random_matrix<3>(nrows, ncols);
+        auto [echelon, rank] = row_echelon_form(matrix);
+        auto sparse_rank = row_echelon_form(SparseMatrix<Z3>(matrix));
+        EXPECT_PRED1(is_row_echelon<Z3>, echelon);
+        EXPECT_EQ(rank, sparse_rank.non_empty_rows);
+        EXPECT_EQ(rank, row_echelon_form(matrix.transpose()).non_empty_rows);
+    }
+    EXPECT_EQ(row_echelon_form(Matrix<Z3>::id(100)).non_empty_rows, 100);
+    EXPECT_EQ(row_echelon_form(Matrix<Z3>::zero(3, 4)).non_empty_rows, 0);
+    Matrix<Z3> const regular(std::vector<Z3> {1, 1, 1, 2}, 2, 2);
+    EXPECT_EQ(row_echelon_form(regular).non_empty_rows, 2);
+    // the determinant is -3
+    Matrix<Z3> const singular(std::vector<Z3> {1, 2, 2, 1}, 2, 2);
+    EXPECT_EQ(row_echelon_form(singular).non_empty_rows, 1);
+}
@@ -0,0 +1,122 @@
+/// \file bitmap_cubical_complex.h
+/// \brief A file containing a cubical complex stored as a bitmap of
+///        cells of a box
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <ranges>
+#include <vector>
+
+#include "voxel_homology.h"
+
+namespace complexes {
+
+/// \brief A class representing a cubical complex contained in a box
+///        of voxels
+///
+/// A cell [a1, b1]x[a2, b2]x[a3, b3] of the box is identified with its
+/// coordinates (a1 + b1, a2 + b2, a3 + b3), shifted so that the lower
+/// corner of the box has coordinates (1, 1, 1). A coordinate is then
+/// even exactly for the nontrivial intervals. A box of n1 x n2 x n3
+/// voxels has (2n1 + 1)(2n2 + 1)(2n3 + 1) cells, which are stored in
+/// a bitmap surrounded by a layer of cells that are never present.
+/// Thanks to the padding, faces and cofaces of a cell are obtained by
+/// adding or subtracting strides from its index, without any bounds
+/// checks or hashing.
+class BitmapCubicalComplex {
+public:
+    /// \brief Constructs an empty complex in a box
+    ///
+    /// The box consists of voxels v with lower <= v < upper on every
+    /// axis.
+    ///
+    /// \param lower Lower corner of the box
+    /// \param upper Upper corner of the box, exclusive
+    BitmapCubicalComplex(Voxel lower, Voxel upper);
+
+    /// \brief Adds a voxel together with all its faces
+    ///
+    /// Throws std::out_of_range, if the voxel is outside of the box.
+    void add_cube(Voxel voxel);
+
+    /// \brief Number of indices of cells, including the padding
+    std::size_t size() const;
+
+    /// \brief Checks, whether the cell with given index is present
+    bool contains(std::size_t cell) const;
+
+    /// \brief Dimension of the cell with given index
+    std::size_t dimension(std::size_t cell) const;
+
+    /// \brief Lazily enumerates indices of faces of a cell
+    ///
+    /// Faces are enumerated in the same order as by
+    /// `CubicalSimplex::boundary_faces`.
+    ///
+    /// \param cell Index of a cell in the box, not in the padding
+    auto boundary_faces(std::size_t cell) const {
+        auto const strides = axis_strides(cell, true);
+        return std::views::iota(std::size_t {0}, 2 * strides.count)
+            | std::views::transform([cell, strides](std::size_t k) {
+                   auto const stride = strides.strides[k / 2];
+                   return k % 2 == 0 ? cell + stride : cell - stride;
+               });
+    }
+
+    /// \brief Lazily enumerates indices of cofaces of a cell
+    ///
+    /// Cofaces are enumerated in the same order as by
+    /// `CubicalSimplex::coboundary_faces`. Cofaces outside of the box
+    /// fall into the padding, so they are never present.
+    ///
+    /// \param cell Index of a cell in the box, not in the padding
+    auto coboundary_faces(std::size_t cell) const {
+        auto const strides = axis_strides(cell, false);
+        return std::views::iota(std::size_t {0}, 2 * strides.count)
+            | std::views::transform([cell, strides](std::size_t k) {
+                   auto const stride = strides.strides[k / 2];
+                   return k % 2 == 0 ? cell - stride : cell + stride;
+               });
+    }
+
+    /// \brief Reduces the complex using elementary collapses
+    ///
+    /// Same as `CubicalComplex::collapse`, but works on indices of
+    /// cells.
+    ///
+    /// \return Number of removed pairs of cells
+    std::size_t collapse();
+
+private:
+    /// \brief Strides of the axes, on which a cell has intervals of
+    ///        a given kind
+    struct AxisStrides {
+        /// \brief Strides of the axes, the first `count` are valid
+        std::array<std::size_t, 3> strides = {};
+        /// \brief Number of the axes
+        std::size_t count = 0;
+    };
+
+    /// \brief Computes strides of the axes, on which a cell has
+    ///        nontrivial or trivial intervals
+    AxisStrides axis_strides(std::size_t cell, bool nontrivial) const;
+
+    /// \brief Returns the only coface of a cell, if it has exactly one
+    std::optional<std::size_t> unique_coface(std::size_t cell) const;
+
+    /// \brief Lower corner of the box
+    Voxel m_lower;
+    /// \brief Upper corner of the box, exclusive
+    Voxel m_upper;
+    /// \brief Number of cells on every axis, including the padding
+    std::array<std::size_t, 3> m_extents = {};
+    /// \brief Difference of indices of neighbouring cells on every
+    ///        axis
+    std::array<std::size_t, 3> m_strides = {};
+    /// \brief Presence of cells
+    std::vector<bool> m_cells;
+};
+
+} // namespace complexes
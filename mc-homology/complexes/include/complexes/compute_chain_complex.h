@@ -3,52 +3,122 @@
 ///        chain complexes.
 #pragma once
 
+#include <array>
+#include <limits>
 #include <ranges>
-#include <unordered_map>
 #include <vector>
 
 #include "algebra/chain_complex.h"
-#include "algebra/matrix.h"
+#include "algebra/sparse_matrix.h"
+#include "bitmap_cubical_complex.h"
 #include "cubical_complex.h"
 
 namespace complexes {
 
 /// \brief Computes a chain complex from a cubical complex
 ///
-/// Transforms relationships between faces into boundary operators
+/// Transforms relationships between faces into boundary operators.
+/// The boundary operators are stored as sparse matrices, since every
+/// column of a cubical boundary has at most `2 * ambient_dimension()`
+/// non-zero coefficients. Rows and columns are the indices of
+/// simplices in the complex, so the matrices are assembled in a single
+/// pass over the simplices.
 ///
 /// \param cubical_complex Complex to transorm
 ///
 /// \result A chain complex
 template<class T>
-algebra::ChainComplex<T>
+algebra::ChainComplex<T, algebra::SparseMatrix<T>>
 compute_chain_complex(CubicalComplex const& cubical_complex) {
     namespace vs = std::views;
+    using SparseMatrix = algebra::SparseMatrix<T>;
     auto const& simplices = cubical_complex.simplices();
     if (simplices.empty()) {
-        return algebra::ChainComplex<T> {};
+        return algebra::ChainComplex<T, SparseMatrix> {};
     }
-    std::vector<algebra::Matrix<T>> boundaries(simplices.size());
+    std::vector<SparseMatrix> boundaries(simplices.size());
     // 0'th dimensional matrix is empty, we are computing non-reduced
     // homology
-    boundaries[0] = algebra::Matrix<T>::zero(0, simplices[0].size());
+    boundaries[0] = SparseMatrix::zero(0, simplices[0].size());
     for (std::size_t dim = 1; dim < simplices.size(); ++dim) {
-        boundaries[dim] = algebra::Matrix<T>::zero(
-            simplices[dim - 1].size(),
-            simplices[dim].size()
-        );
-        std::unordered_map<CubicalSimplex, std::size_t> assigned_rows;
-        for (auto const& [s, i] : vs::zip(simplices[dim - 1], vs::iota(0))) {
-            assigned_rows.emplace(s, i);
-        }
-        for (auto const& [j, simplex] : simplices[dim] | vs::enumerate) {
+        std::vector<typename SparseMatrix::column_type> columns;
+        columns.reserve(simplices[dim].size());
+        for (auto const& simplex : simplices[dim]) {
             std::array sgn = {1, -1, -1, 1};
-            for (auto const& [k, bd] : simplex.boundary() | vs::enumerate) {
-                boundaries[dim][assigned_rows[bd], j] = sgn[k % sgn.size()];
+            auto& column = columns.emplace_back();
+            for (auto const& [k, bd] :
+                 simplex.boundary_faces() | vs::enumerate) {
+                column.push_back(
+                    {.row = cubical_complex.index(bd),
+                     .value = sgn[k % sgn.size()]}
+                );
             }
         }
+        boundaries[dim] =
+            SparseMatrix(std::move(columns), simplices[dim - 1].size());
+    }
+    return algebra::ChainComplex<T, SparseMatrix> {std::move(boundaries)};
+}
+
+/// \brief Computes a chain complex from a bitmap cubical complex
+///
+/// Cells of every dimension are numbered in the order of their indices
+/// in the bitmap, so rows of the boundary operators are looked up in
+/// an array instead of a hash map.
+///
+/// \param bitmap_complex Complex to transform
+///
+/// \result A chain complex
+template<class T>
+algebra::ChainComplex<T, algebra::SparseMatrix<T>>
+compute_chain_complex(BitmapCubicalComplex const& bitmap_complex) {
+    namespace vs = std::views;
+    using SparseMatrix = algebra::SparseMatrix<T>;
+    constexpr auto unassigned = std::numeric_limits<std::size_t>::max();
+    std::vector<std::size_t> assigned_rows(bitmap_complex.size(), unassigned);
+    std::array<std::size_t, 4> counts = {};
+    for (std::size_t cell = 0; cell < bitmap_complex.size(); ++cell) {
+        if (bitmap_complex.contains(cell)) {
+            assigned_rows[cell] = counts[bitmap_complex.dimension(cell)]++;
+        }
+    }
+    if (counts[0] == 0) {
+        return algebra::ChainComplex<T, SparseMatrix> {};
+    }
+    std::array<std::vector<typename SparseMatrix::column_type>, 4> columns;
+    for (std::size_t dim = 1; dim < columns.size(); ++dim) {
+        columns[dim].reserve(counts[dim]);
+    }
+    for (std::size_t cell = 0; cell < bitmap_complex.size(); ++cell) {
+        if (!bitmap_complex.contains(cell)) {
+            continue;
+        }
+        auto const dim = bitmap_complex.dimension(cell);
+        if (dim == 0) {
+            continue;
+        }
+        std::array sgn = {1, -1, -1, 1};
+        auto& column = columns[dim].emplace_back();
+        for (auto const& [k, face] :
+             bitmap_complex.boundary_faces(cell) | vs::enumerate) {
+            column.push_back(
+                {.row = assigned_rows[face], .value = sgn[k % sgn.size()]}
+            );
+        }
+    }
+    auto top = counts.size() - 1;
+    while (counts[top] == 0) {
+        --top;
+    }
+    std::vector<SparseMatrix> boundaries(top + 1);
+    // 0'th dimensional matrix is empty, we are computing non-reduced
+    // homology
+    boundaries[0] = SparseMatrix::zero(0, counts[0]);
+    for (std::size_t dim = 1; dim <= top; ++dim) {
+        boundaries[dim] =
+            SparseMatrix(std::move(columns[dim]), counts[dim - 1]);
     }
-    return algebra::ChainComplex<T> {std::move(boundaries)};
+    return algebra::ChainComplex<T, SparseMatrix> {std::move(boundaries)};
 }
 
 } // namespace complexes
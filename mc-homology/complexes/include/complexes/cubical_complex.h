@@ -3,13 +3,19 @@
 
 #pragma once
 
+#include <array>
 #include <compare>
+#include <cstdint>
 #include <format>
+#include <functional>
 #include <iostream>
+#include <optional>
 #include <ranges>
-#include <unordered_set>
+#include <span>
 #include <vector>
 
+#include "flat_hash_map.h"
+
 namespace complexes {
 
 /// \brief A struct representing an interval of length 0 or 1
@@ -60,15 +66,22 @@ std::ostream& operator<<(std::ostream& output, BasicInterval i);
 /// A cubical simplex is a product of basic intervals. The number of
 /// intervals is equal to the ambient dimension, while the number of
 /// non trivial intervals is equal to the dimension of the simplex.
+///
+/// The intervals are stored inline, so the ambient dimension can be
+/// at most `max_ambient_dimension` and simplices never allocate.
 class CubicalSimplex {
 public:
-    /// \brief Constructs a simplex from a vector of intervals
+    /// \brief The largest supported ambient dimension
+    constexpr static std::size_t max_ambient_dimension = 3;
+
+    /// \brief Constructs a simplex from a range of intervals
     ///
-    /// Constructs a simplex from a vector of intervals. The interval
-    /// must have at least one value.
+    /// Constructs a simplex from a range of intervals. The range
+    /// must have at least one and at most `max_ambient_dimension`
+    /// values.
     ///
-    /// \param intervals A nonempty vector of intervals
-    CubicalSimplex(std::vector<BasicInterval> intervals);
+    /// \param intervals A nonempty range of intervals
+    CubicalSimplex(std::span<BasicInterval const> intervals);
 
     /// \brief Returns the dimension of the simplex
     std::size_t dimension() const;
@@ -84,11 +97,56 @@ public:
     /// The returned boundary is decresing in the sense of operator<=>.
     std::vector<CubicalSimplex> boundary() const;
 
+    /// \brief Returns a view of the boundary of a simplex
+    ///
+    /// Allocation-free version of `boundary`, the faces are computed
+    /// lazily in the same order.
+    auto boundary_faces() const {
+        return std::views::iota(std::size_t {0}, 2 * dimension())
+            | std::views::transform([simplex = *this](std::size_t k) {
+                   return simplex.boundary_face(k);
+               });
+    }
+
+    /// \brief Returns the k'th face of the simplex in the order of
+    ///        `boundary`
+    ///
+    /// \param k Index of the face, smaller than `2 * dimension()`
+    CubicalSimplex boundary_face(std::size_t k) const;
+
+    /// \brief Returns the potential coboundary of a simplex
+    ///
+    /// Returns all simplices of one higher dimension, which contain the
+    /// simplex in their boundary. The returned simplices do not have to
+    /// be a part of any complex.
+    std::vector<CubicalSimplex> coboundary() const;
+
+    /// \brief Returns a view of the potential coboundary of a simplex
+    ///
+    /// Allocation-free version of `coboundary`, the cofaces are
+    /// computed lazily in the same order.
+    auto coboundary_faces() const {
+        return std::views::iota(
+                   std::size_t {0},
+                   2 * (ambient_dimension() - dimension())
+               )
+            | std::views::transform([simplex = *this](std::size_t k) {
+                   return simplex.coboundary_face(k);
+               });
+    }
+
+    /// \brief Returns the k'th coface of the simplex in the order of
+    ///        `coboundary`
+    ///
+    /// \param k Index of the coface, smaller than
+    ///        `2 * (ambient_dimension() - dimension())`
+    CubicalSimplex coboundary_face(std::size_t k) const;
+
     /// \brief Compares two simplices
     bool operator==(CubicalSimplex const&) const;
 
     /// \brief Returns the underlying intervals
-    std::vector<BasicInterval> const& intervals() const;
+    std::span<BasicInterval const> intervals() const;
 
     /// \brief Comparison operator for simplices
     ///
@@ -117,7 +175,8 @@ public:
     /// \brief Creates a cubical simplex by joining together two simplices
     ///
     /// Creates a simplex in a higher dimension by taking a cartesian
-    /// product and concatenating them
+    /// product and concatenating them. The sum of ambient dimensions
+    /// cannot exceed `max_ambient_dimension`.
     ///
     /// \param s1 First simplex
     /// \param s2 Second simplex
@@ -130,15 +189,36 @@ private:
     /// \brief Creates an empty simplex
     CubicalSimplex();
 
-    /// \brief Stores intervals defining a simplex
-    std::vector<BasicInterval> m_intervals = {};
+    /// \brief Stores intervals defining a simplex, the unused ones are
+    ///        default constructed
+    std::array<BasicInterval, max_ambient_dimension> m_intervals = {};
+    /// \brief Stores the number of intervals
+    std::uint8_t m_ambient_dimension = 0;
     /// \brief Stores the number of non-trivial intervals
-    std::size_t m_dimension = 0;
+    std::uint8_t m_dimension = 0;
 };
 
 /// \brief Prints a cubical simplex to output
 std::ostream& operator<<(std::ostream& output, CubicalSimplex const& s);
 
+} // namespace complexes
+
+/// \brief std::hash specialization for Interval
+template<>
+struct std::hash<complexes::BasicInterval> {
+    /// \brief Returns a hash of an interval
+    std::size_t operator()(complexes::BasicInterval const& i) const;
+};
+
+/// \brief std::hash specialization for CubicalSimplex
+template<>
+struct std::hash<complexes::CubicalSimplex> {
+    /// \brief Returns a hash of a cubical simplex
+    std::size_t operator()(complexes::CubicalSimplex const& s) const;
+};
+
+namespace complexes {
+
 /// \brief Class representing a cubical complex
 ///
 /// A class representing a topological space constructed from cubical
@@ -171,7 +251,8 @@ public:
     ///
     /// In order to remove a cubical complex, it has to have an empty
     /// coboundary, that is, it cannot be a part of the boundary of any
-    /// other simplex
+    /// other simplex. The check uses the maintained number of cofaces,
+    /// so removal takes constant time.
     ///
     /// \param simplex Simplex to remove
     ///
@@ -186,14 +267,45 @@ public:
     ///         otherwise
     bool contains(CubicalSimplex const& simplex) const;
 
+    /// \brief Reduces the complex using elementary collapses
+    ///
+    /// Repeatedly removes a free face, that is a simplex contained in
+    /// the boundary of exactly one other simplex of the complex,
+    /// together with its unique coface. Every such collapse is
+    /// a deformation retraction, so the homology of the complex does
+    /// not change.
+    ///
+    /// \return The number of removed pairs of simplices
+    std::size_t collapse();
+
     /// \brief Equality comparison operator
     bool operator==(CubicalComplex const&) const;
 
     /// \brief Grants access to the simplexes of the complex
     ///
     /// The simplices are returned in a vector, where `n`'th element
-    /// is a unordered set containing simplices of dimension `n`.
-    std::vector<std::unordered_set<CubicalSimplex>> const& simplices() const;
+    /// is a vector containing simplices of dimension `n` ordered by
+    /// their indices.
+    std::vector<std::vector<CubicalSimplex>> const& simplices() const;
+
+    /// \brief Returns the index of a simplex among simplices of its
+    ///        dimension
+    ///
+    /// Indices are dense and assigned in the order of insertion. When
+    /// a simplex is removed, the last simplex of its dimension takes
+    /// over its index.
+    ///
+    /// Throws std::out_of_range, if the simplex is not in the complex.
+    std::size_t index(CubicalSimplex const& simplex) const;
+
+    /// \brief Returns the number of simplices of the complex, whose
+    ///        boundary contains a simplex
+    ///
+    /// The numbers are maintained on insertion and removal, so a free
+    /// face is recognized in constant time.
+    ///
+    /// Throws std::out_of_range, if the simplex is not in the complex.
+    std::size_t coface_count(CubicalSimplex const& simplex) const;
 
     /// \brief Returns the dimension of the simplex
     std::size_t dimension() const;
@@ -202,29 +314,45 @@ public:
     std::size_t ambient_dimension() const;
 
 private:
+    /// \brief Data kept for every simplex of the complex
+    struct Cell {
+        /// \brief Index of the simplex in `m_simplices`
+        std::size_t index = 0;
+        /// \brief Number of cofaces of the simplex in the complex
+        std::size_t coface_count = 0;
+    };
+
     /// \brief Implementation of the recursive add algorithm
     void add_recursive_impl(CubicalSimplex simplex);
 
-    /// \brief Simplexes in the comples stored by dimension
-    std::vector<std::unordered_set<CubicalSimplex>> m_simplices;
-};
+    /// \brief Inserts a simplex without checking its boundary
+    ///
+    /// Updates numbers of cofaces of its faces.
+    ///
+    /// \return true, if the simplex was not in the complex yet
+    bool insert(CubicalSimplex simplex);
 
-} // namespace complexes
+    /// \brief Erases a simplex without checking its coboundary
+    ///
+    /// The last simplex of the same dimension is moved into its place.
+    /// Updates numbers of cofaces of its faces.
+    void erase(CubicalSimplex const& simplex);
 
-/// \brief std::hash specialization for Interval
-template<>
-struct std::hash<complexes::BasicInterval> {
-    /// \brief Returns a hash of an interval
-    std::size_t operator()(complexes::BasicInterval const& i) const;
-};
+    /// \brief Returns the only coface of a simplex in the complex
+    ///
+    /// \return The coface, if the simplex is a free face, nullopt
+    ///         otherwise
+    std::optional<CubicalSimplex>
+    unique_coface(CubicalSimplex const& simplex) const;
 
-/// \brief std::hash specialization for CubicalSimplex
-template<>
-struct std::hash<complexes::CubicalSimplex> {
-    /// \brief Returns a hash of a cubical simplex
-    std::size_t operator()(complexes::CubicalSimplex const& s) const;
+    /// \brief Simplexes in the comples stored by dimension
+    std::vector<std::vector<CubicalSimplex>> m_simplices;
+    /// \brief Indices and numbers of cofaces of the simplexes
+    FlatHashMap<CubicalSimplex, Cell> m_cells;
 };
 
+} // namespace complexes
+
 /// \brief Formatter for BasicInterval type
 ///
 /// Allows use of `std::format` with the `BasicInterval` type. The format
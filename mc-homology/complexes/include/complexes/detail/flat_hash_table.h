@@ -0,0 +1,274 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "complexes/utils.h"
+
+namespace complexes {
+namespace detail {
+
+/// \brief An open-addressing hash table, shared by `FlatHashSet` and
+///        `FlatHashMap`
+///
+/// \tparam Entry Type of the stored entries
+/// \tparam KeyOf Function object returning the key of an entry
+/// \tparam Hash Hash function of the keys
+template<class Entry, class KeyOf, class Hash>
+class FlatHashTable {
+public:
+    /// \brief Type of the keys
+    using key_type = std::remove_cvref_t<
+        std::invoke_result_t<KeyOf, Entry const&>>;
+    /// \brief Type of the entries
+    using value_type = Entry;
+    /// \brief Type of sizes
+    using size_type = std::size_t;
+
+    /// \brief A forward iterator over entries of the table
+    class iterator {
+    public:
+        using iterator_concept = std::forward_iterator_tag;
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Entry;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Entry const*;
+        using reference = Entry const&;
+
+        iterator() = default;
+
+        reference operator*() const {
+            return **m_slot;
+        }
+
+        pointer operator->() const {
+            return &**m_slot;
+        }
+
+        iterator& operator++() {
+            ++m_slot;
+            skip_empty();
+            return *this;
+        }
+
+        iterator operator++(int) {
+            auto copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        bool operator==(iterator const&) const = default;
+
+    private:
+        friend class FlatHashTable;
+
+        using slot_iterator =
+            typename std::vector<std::optional<Entry>>::const_iterator;
+
+        iterator(slot_iterator slot, slot_iterator end) :
+            m_slot(slot),
+            m_end(end) {
+            skip_empty();
+        }
+
+        void skip_empty() {
+            while (m_slot != m_end && !m_slot->has_value()) {
+                ++m_slot;
+            }
+        }
+
+        slot_iterator m_slot {};
+        slot_iterator m_end {};
+    };
+
+    /// \brief Same as iterator, entries are immutable through iterators
+    using const_iterator = iterator;
+
+    /// \brief Inserts an entry constructed from arguments, if its key
+    ///        is not present yet
+    ///
+    /// \return Iterator to the entry with the key of the constructed
+    ///         one and true, if the entry has been inserted
+    template<class... Args>
+    std::pair<iterator, bool> emplace(Args&&... args) {
+        Entry entry(std::forward<Args>(args)...);
+        if ((m_size + 1) * max_load_denominator
+            > m_slots.size() * max_load_numerator) {
+            rehash(std::max(min_capacity, 2 * m_slots.size()));
+        }
+        auto const slot = find_slot(m_key_of(entry));
+        if (m_slots[slot]) {
+            return {make_iterator(slot), false};
+        }
+        m_slots[slot].emplace(std::move(entry));
+        ++m_size;
+        return {make_iterator(slot), true};
+    }
+
+    /// \brief Erases the entry with a key
+    ///
+    /// \return Number of erased entries, either 0 or 1
+    size_type erase(key_type const& key) {
+        if (m_size == 0) {
+            return 0;
+        }
+        auto hole = find_slot(key);
+        if (!m_slots[hole]) {
+            return 0;
+        }
+        m_slots[hole].reset();
+        --m_size;
+        // shift back entries of the probe sequence, which would be
+        // unreachable behind the hole
+        auto const mask = m_slots.size() - 1;
+        for (auto slot = (hole + 1) & mask; m_slots[slot];
+             slot = (slot + 1) & mask) {
+            auto const home = home_slot(m_key_of(*m_slots[slot]));
+            if (((slot - home) & mask) >= ((slot - hole) & mask)) {
+                m_slots[hole] = std::move(m_slots[slot]);
+                m_slots[slot].reset();
+                hole = slot;
+            }
+        }
+        return 1;
+    }
+
+    /// \brief Finds the entry with a key
+    ///
+    /// \return Iterator to the entry or end(), if it is not present
+    iterator find(key_type const& key) const {
+        if (m_size == 0) {
+            return end();
+        }
+        auto const slot = find_slot(key);
+        return m_slots[slot] ? make_iterator(slot) : end();
+    }
+
+    /// \brief Checks, whether an entry with a key is present
+    bool contains(key_type const& key) const {
+        return m_size != 0 && m_slots[find_slot(key)].has_value();
+    }
+
+    /// \brief Number of entries
+    size_type size() const {
+        return m_size;
+    }
+
+    /// \brief Checks, whether the table is empty
+    bool empty() const {
+        return m_size == 0;
+    }
+
+    /// \brief Removes all entries
+    void clear() {
+        m_slots.clear();
+        m_size = 0;
+    }
+
+    /// \brief Prepares the table for storing count entries without
+    ///        rehashing
+    void reserve(size_type count) {
+        auto capacity = std::max(min_capacity, m_slots.size());
+        while (count * max_load_denominator > capacity * max_load_numerator) {
+            capacity *= 2;
+        }
+        if (capacity != m_slots.size()) {
+            rehash(capacity);
+        }
+    }
+
+    /// \brief Iterator to the first entry
+    iterator begin() const {
+        return iterator(m_slots.begin(), m_slots.end());
+    }
+
+    /// \brief Iterator past the last entry
+    iterator end() const {
+        return iterator(m_slots.end(), m_slots.end());
+    }
+
+    /// \brief Checks, whether two tables contain the same entries
+    friend bool
+    operator==(FlatHashTable const& lhs, FlatHashTable const& rhs) {
+        return lhs.size() == rhs.size()
+            && std::ranges::all_of(lhs, [&rhs](Entry const& entry) {
+                   auto const it = rhs.find(rhs.m_key_of(entry));
+                   return it != rhs.end() && *it == entry;
+               });
+    }
+
+protected:
+    /// \brief Finds the entry with a key for modification
+    ///
+    /// The key of the entry must not be modified.
+    ///
+    /// \return Pointer to the entry or nullptr, if it is not present
+    Entry* find_mutable(key_type const& key) {
+        if (m_size == 0) {
+            return nullptr;
+        }
+        auto& slot = m_slots[find_slot(key)];
+        return slot ? &*slot : nullptr;
+    }
+
+private:
+    /// \brief Capacity of a non-empty table, must be a power of 2
+    constexpr static size_type min_capacity = 16;
+    /// \brief Numerator of the maximal ratio of entries to slots
+    constexpr static size_type max_load_numerator = 3;
+    /// \brief Denominator of the maximal ratio of entries to slots
+    constexpr static size_type max_load_denominator = 4;
+
+    iterator make_iterator(size_type slot) const {
+        return iterator(m_slots.begin() + slot, m_slots.end());
+    }
+
+    /// \brief Slot, at which the probe sequence of a key starts
+    size_type home_slot(key_type const& key) const {
+        return utils::mix_hash(m_hash(key)) & (m_slots.size() - 1);
+    }
+
+    /// \brief Finds the slot of a key or the empty slot, where it would
+    ///        be inserted
+    ///
+    /// The table must have at least one empty slot.
+    size_type find_slot(key_type const& key) const {
+        auto const mask = m_slots.size() - 1;
+        auto slot = home_slot(key);
+        while (m_slots[slot] && m_key_of(*m_slots[slot]) != key) {
+            slot = (slot + 1) & mask;
+        }
+        return slot;
+    }
+
+    /// \brief Moves all entries to a table with given capacity
+    void rehash(size_type capacity) {
+        auto old_slots = std::exchange(
+            m_slots,
+            std::vector<std::optional<Entry>>(capacity)
+        );
+        for (auto& old_slot : old_slots) {
+            if (old_slot) {
+                m_slots[find_slot(m_key_of(*old_slot))] = std::move(old_slot);
+            }
+        }
+    }
+
+    /// \brief Slots of the table, its size is 0 or a power of 2
+    std::vector<std::optional<Entry>> m_slots;
+    /// \brief Number of entries
+    size_type m_size = 0;
+    /// \brief Function returning keys of entries
+    [[no_unique_address]] KeyOf m_key_of {};
+    /// \brief Hash function
+    [[no_unique_address]] Hash m_hash {};
+};
+
+} // namespace detail
+} // namespace complexes
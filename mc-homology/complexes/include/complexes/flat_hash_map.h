@@ -0,0 +1,82 @@
+/// \file flat_hash_map.h
+/// \brief A file containing an open-addressing hash map
+#pragma once
+
+#include <functional>
+#include <stdexcept>
+#include <utility>
+
+#include "detail/flat_hash_table.h"
+
+namespace complexes {
+
+namespace detail {
+
+/// \brief Returns the key of a key-value pair
+struct PairKey {
+    template<class K, class V>
+    constexpr K const& operator()(std::pair<K, V> const& entry) const {
+        return entry.first;
+    }
+};
+
+} // namespace detail
+
+/// \brief A hash map storing its key-value pairs in a single array
+///
+/// Same as `FlatHashSet`, but every key has an associated value.
+/// Entries are immutable through iterators, values are modified with
+/// `at` or `find_value`.
+///
+/// Inserting or erasing an entry invalidates all iterators and
+/// references.
+///
+/// \tparam K Type of the keys
+/// \tparam V Type of the values
+/// \tparam Hash Hash function of the keys
+template<class K, class V, class Hash = std::hash<K>>
+class FlatHashMap:
+    public detail::FlatHashTable<std::pair<K, V>, detail::PairKey, Hash> {
+public:
+    /// \brief Finds the value of a key
+    ///
+    /// \return Pointer to the value or nullptr, if the key is not
+    ///         present
+    V* find_value(K const& key) {
+        auto* entry = this->find_mutable(key);
+        return entry ? &entry->second : nullptr;
+    }
+
+    /// \brief Finds the value of a key
+    ///
+    /// \return Pointer to the value or nullptr, if the key is not
+    ///         present
+    V const* find_value(K const& key) const {
+        auto const it = this->find(key);
+        return it != this->end() ? &it->second : nullptr;
+    }
+
+    /// \brief Accesses the value of a key
+    ///
+    /// Throws std::out_of_range, if the key is not present.
+    V& at(K const& key) {
+        auto* value = find_value(key);
+        if (!value) [[unlikely]] {
+            throw std::out_of_range("Key not present in the map");
+        }
+        return *value;
+    }
+
+    /// \brief Accesses the value of a key
+    ///
+    /// Throws std::out_of_range, if the key is not present.
+    V const& at(K const& key) const {
+        auto const* value = find_value(key);
+        if (!value) [[unlikely]] {
+            throw std::out_of_range("Key not present in the map");
+        }
+        return *value;
+    }
+};
+
+} // namespace complexes
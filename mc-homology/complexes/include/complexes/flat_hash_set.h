@@ -0,0 +1,46 @@
+/// \file flat_hash_set.h
+/// \brief A file containing an open-addressing hash set
+#pragma once
+
+#include <functional>
+#include <initializer_list>
+#include <utility>
+
+#include "detail/flat_hash_table.h"
+
+namespace complexes {
+
+/// \brief A hash set storing its elements in a single array
+///
+/// Collisions are resolved with linear probing and elements are erased
+/// with backward shifting, so there are no tombstones and lookups stop
+/// at the first empty slot. Compared to `std::unordered_set` there is
+/// no allocation per element and probing a slot doesn't chase
+/// pointers. Results of `Hash` are mixed with `utils::mix_hash`, so
+/// even identity hashes spread well over the table.
+///
+/// Inserting or erasing an element invalidates all iterators.
+///
+/// \tparam T Type of the elements
+/// \tparam Hash Hash function of the elements
+template<class T, class Hash = std::hash<T>>
+class FlatHashSet: public detail::FlatHashTable<T, std::identity, Hash> {
+public:
+    /// \brief Constructs an empty set
+    FlatHashSet() = default;
+
+    /// \brief Constructs a set from a list of elements
+    FlatHashSet(std::initializer_list<T> values) {
+        this->reserve(values.size());
+        for (auto const& value : values) {
+            this->emplace(value);
+        }
+    }
+
+    /// \brief Inserts an element, if it is not present yet
+    auto insert(T value) {
+        return this->emplace(std::move(value));
+    }
+};
+
+} // namespace complexes
@@ -1,13 +1,24 @@
 /// \file utils.h
 /// \brief Contains auxillary classes and functions
+#pragma once
 
 #include <concepts>
+#include <cstdint>
 #include <ranges>
 
 namespace complexes {
 namespace utils {
 
+/// \brief Mixes bits of a 64-bit value
+///
+/// A bijective finalizer of the splitmix64 generator. Every input bit
+/// affects every output bit.
+std::uint64_t mix_hash(std::uint64_t x);
+
 /// \brief Combines two hashes into a single hash
+///
+/// The result is mixed, so that it can be used directly to index
+/// a table with a power of 2 slots.
 std::size_t combine_hashes(std::size_t hash1, std::size_t hash2);
 
 /// \brief Combines hashes of a range into a single hash
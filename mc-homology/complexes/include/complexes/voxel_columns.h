@@ -0,0 +1,109 @@
+/// \file voxel_columns.h
+/// \brief A file containing a run-length encoded set of voxels
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <map>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "voxel_grid.h"
+#include "voxel_homology.h"
+
+namespace complexes {
+
+/// \brief A half-open interval [begin, end) of y coordinates
+struct Run {
+    /// \brief The lowest y coordinate in the run
+    int begin = 0;
+    /// \brief The y coordinate just above the run
+    int end = 0;
+
+    /// \brief Lexicographic comparison of runs
+    auto operator<=>(Run const&) const = default;
+};
+
+/// \brief A set of voxels stored as runs along vertical columns
+///
+/// Every column (x, z) keeps a sorted list of disjoint, non-adjacent
+/// runs of voxels, so the size of the set is proportional to the
+/// number of transitions between solid and empty blocks along y,
+/// rather than to its volume.
+class VoxelColumns {
+public:
+    /// \brief Constructs an empty set
+    VoxelColumns() = default;
+
+    /// \brief Encodes voxels of a grid
+    explicit VoxelColumns(VoxelGrid const& grid);
+
+    /// \brief Adds a run of voxels to a column
+    ///
+    /// The run has to start at or above the end of the last run of the
+    /// column. Runs touching the last run are merged with it, empty
+    /// runs are ignored.
+    ///
+    /// \param x x coordinate of the column
+    /// \param z z coordinate of the column
+    /// \param run The run
+    void append(int x, int z, Run run);
+
+    /// \brief Returns the runs of a column, from the bottom
+    std::span<Run const> column(int x, int z) const;
+
+    /// \brief Number of non-empty columns
+    std::size_t column_count() const;
+
+    /// \brief Total number of runs
+    std::size_t run_count() const;
+
+    /// \brief Number of voxels
+    std::size_t size() const;
+
+    /// \brief Computes the smallest box containing all voxels
+    ///
+    /// \return Lower corner and exclusive upper corner of the box, or
+    ///         nullopt if the set is empty
+    std::optional<std::pair<Voxel, Voxel>> bounding_box() const;
+
+    /// \brief Lists y coordinates, at which any run begins or ends
+    ///
+    /// \return Sorted coordinates without repetitions
+    std::vector<int> breakpoints() const;
+
+    /// \brief Squeezes every layer between two consecutive breakpoints
+    ///        into a single layer of voxels
+    ///
+    /// Between two consecutive breakpoints every column is either
+    /// entirely solid or entirely empty, so the map sending the k'th
+    /// breakpoint to k and linear in between is a homeomorphism of R^3
+    /// onto itself taking the union of the voxels onto the union of
+    /// the squeezed voxels. The homology is thus the same, while the
+    /// height becomes the number of breakpoints.
+    VoxelColumns compress_y() const;
+
+    /// \brief Calls f(x, z, run) for every run
+    ///
+    /// Columns are visited in the lexicographic order of (x, z), runs
+    /// from the bottom.
+    template<class F>
+    void for_each_run(F&& f) const {
+        for (auto const& [column, runs] : m_columns) {
+            for (auto const& run : runs) {
+                f(column.first, column.second, run);
+            }
+        }
+    }
+
+    /// \brief Equality of sets of voxels
+    bool operator==(VoxelColumns const&) const = default;
+
+private:
+    /// \brief Runs of non-empty columns by their (x, z) coordinates
+    std::map<std::pair<int, int>, std::vector<Run>> m_columns;
+};
+
+} // namespace complexes
@@ -0,0 +1,105 @@
+/// \file voxel_grid.h
+/// \brief A file containing a sparse bit-packed set of voxels
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "voxel_homology.h"
+
+namespace complexes {
+
+/// \brief A set of voxels stored as bitmasks of 16x16x16 sections
+///
+/// Only sections containing a voxel are stored, so empty space costs
+/// nothing, and every stored voxel takes a single bit. Sections are
+/// aligned to multiples of 16, like sections of Minecraft chunks, so
+/// decoded chunk sections are inserted whole.
+///
+/// Voxels are visited section by section, in the lexicographic order
+/// of sections, so the order doesn't depend on the order of insertion.
+class VoxelGrid {
+public:
+    /// \brief Number of voxels along each side of a section
+    constexpr static int section_side = 16;
+
+    /// \brief Bitmask of voxels of a section
+    ///
+    /// Bit `i % 64` of word `i / 64` stands for the voxel with local
+    /// coordinates (x, y, z), where i = (y * 16 + z) * 16 + x.
+    using Section = std::array<std::uint64_t, 64>;
+
+    /// \brief Adds a voxel
+    void insert(Voxel voxel);
+
+    /// \brief Adds all voxels of a bitmask of a section
+    ///
+    /// \param section Coordinates of the section, in sections
+    /// \param voxels Bitmask of voxels to add
+    void insert_section(Voxel section, Section const& voxels);
+
+    /// \brief Checks, whether the grid contains a voxel
+    bool contains(Voxel voxel) const;
+
+    /// \brief Checks, whether the grid contains no voxels
+    bool empty() const;
+
+    /// \brief Number of voxels
+    std::size_t size() const;
+
+    /// \brief Number of stored sections
+    std::size_t section_count() const;
+
+    /// \brief Computes the smallest box containing all voxels
+    ///
+    /// \return Lower corner and exclusive upper corner of the box, or
+    ///         nullopt if the grid is empty
+    std::optional<std::pair<Voxel, Voxel>> bounding_box() const;
+
+    /// \brief Lists all voxels in the order of visiting
+    std::vector<Voxel> voxels() const;
+
+    /// \brief Calls f(voxel) for every voxel
+    template<class F>
+    void for_each(F&& f) const {
+        for (auto const& [section, voxels] : m_sections) {
+            for (std::size_t word = 0; word < voxels.size(); ++word) {
+                for (auto bits = voxels[word]; bits != 0; bits &= bits - 1) {
+                    auto const i =
+                        static_cast<int>(64 * word) + std::countr_zero(bits);
+                    f(Voxel {
+                        .x = section_side * section.x + i % 16,
+                        .y = section_side * section.y + i / 256,
+                        .z = section_side * section.z + i / 16 % 16,
+                    });
+                }
+            }
+        }
+    }
+
+    /// \brief Calls f(section, voxels) for every stored section
+    ///
+    /// Sections are visited in the lexicographic order of their
+    /// coordinates, which are given in sections.
+    template<class F>
+    void for_each_section(F&& f) const {
+        for (auto const& [section, voxels] : m_sections) {
+            f(section, voxels);
+        }
+    }
+
+    /// \brief Equality of sets of voxels
+    bool operator==(VoxelGrid const&) const = default;
+
+private:
+    /// \brief Non-empty sections by their coordinates, in sections
+    std::map<Voxel, Section> m_sections;
+};
+
+} // namespace complexes
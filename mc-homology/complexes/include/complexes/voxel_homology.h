@@ -0,0 +1,51 @@
+/// \file voxel_homology.h
+/// \brief A file containing a matrix-free homology algorithm for sets
+///        of voxels
+
+#pragma once
+
+#include <compare>
+#include <span>
+#include <vector>
+
+namespace complexes {
+
+/// \brief A struct representing a unit cube in a 3 dimensional space
+///
+/// A voxel with coordinates (x, y, z) is the cube
+/// [x, x + 1]x[y, y + 1]x[z, z + 1].
+struct Voxel {
+    /// \brief x coordinate
+    int x = 0;
+    /// \brief y coordinate
+    int y = 0;
+    /// \brief z coordinate
+    int z = 0;
+
+    /// \brief Lexicographic comparison of voxels
+    auto operator<=>(Voxel const&) const = default;
+};
+
+/// \brief Computes Betti numbers of a union of voxels
+///
+/// Homology of a subset of R^3 is determined by three numbers:
+/// 1. b0 is the number of connected components, computed with
+///    union-find over voxels sharing at least a vertex,
+/// 2. b2 is the number of bounded components of the complement
+///    (Alexander duality), computed with union-find over empty cells
+///    sharing a face,
+/// 3. the Euler characteristic, computed by counting cells of the
+///    cubical complex around every lattice point.
+///
+/// Then b1 = b0 + b2 - chi. Homology of such sets is torsion-free, so
+/// the returned numbers are the same for any coefficients. The running
+/// time is linear in the volume of the bounding box of the voxels and
+/// no matrices are built.
+///
+/// \param voxels Voxels of the set, may contain duplicates
+///
+/// \return Betti numbers in dimensions 0 to 3, or an empty vector if
+///         there are no voxels
+std::vector<std::size_t> voxel_betti_numbers(std::span<Voxel const> voxels);
+
+} // namespace complexes
@@ -0,0 +1,132 @@
+#include "../include/complexes/bitmap_cubical_complex.h"
+
+#include <array>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+namespace complexes {
+
+BitmapCubicalComplex::BitmapCubicalComplex(Voxel lower, Voxel upper) :
+    m_lower(lower),
+    m_upper(upper) {
+    if (upper.x < lower.x || upper.y < lower.y || upper.z < lower.z) {
+        throw std::domain_error("Upper corner of the box is below the lower");
+    }
+    // 2n + 1 cells of the box and one layer of padding on every side
+    auto const extent = [](int l, int u) {
+        return 2 * static_cast<std::size_t>(static_cast<long>(u) - l) + 3;
+    };
+    m_extents = {
+        extent(lower.x, upper.x),
+        extent(lower.y, upper.y),
+        extent(lower.z, upper.z),
+    };
+    m_strides = {m_extents[1] * m_extents[2], m_extents[2], 1};
+    m_cells.resize(m_extents[0] * m_strides[0]);
+}
+
+void BitmapCubicalComplex::add_cube(Voxel voxel) {
+    if (voxel.x < m_lower.x || voxel.x >= m_upper.x || voxel.y < m_lower.y
+        || voxel.y >= m_upper.y || voxel.z < m_lower.z
+        || voxel.z >= m_upper.z) [[unlikely]] {
+        throw std::out_of_range("Voxel outside of the box");
+    }
+    // the cube [x, x + 1] has coordinate 2 * (x - lower) + 2
+    auto const coordinate = [](int l, int v) {
+        return 2 * static_cast<std::size_t>(static_cast<long>(v) - l) + 2;
+    };
+    auto const center = coordinate(m_lower.x, voxel.x) * m_strides[0]
+        + coordinate(m_lower.y, voxel.y) * m_strides[1]
+        + coordinate(m_lower.z, voxel.z);
+    auto const corner = center - m_strides[0] - m_strides[1] - m_strides[2];
+    for (std::size_t dx = 0; dx < 3; ++dx) {
+        for (std::size_t dy = 0; dy < 3; ++dy) {
+            for (std::size_t dz = 0; dz < 3; ++dz) {
+                m_cells[corner + dx * m_strides[0] + dy * m_strides[1] + dz] =
+                    true;
+            }
+        }
+    }
+}
+
+std::size_t BitmapCubicalComplex::size() const {
+    return m_cells.size();
+}
+
+bool BitmapCubicalComplex::contains(std::size_t cell) const {
+    return m_cells[cell];
+}
+
+std::size_t BitmapCubicalComplex::dimension(std::size_t cell) const {
+    return axis_strides(cell, true).count;
+}
+
+std::size_t BitmapCubicalComplex::collapse() {
+    std::vector<std::size_t> candidates;
+    for (std::size_t cell = 0; cell < size(); ++cell) {
+        if (contains(cell) && dimension(cell) < 3) {
+            candidates.push_back(cell);
+        }
+    }
+    std::size_t collapsed = 0;
+    while (!candidates.empty()) {
+        auto const cell = candidates.back();
+        candidates.pop_back();
+        if (!contains(cell)) {
+            continue;
+        }
+        auto const coface = unique_coface(cell);
+        if (!coface) {
+            continue;
+        }
+        m_cells[*coface] = false;
+        m_cells[cell] = false;
+        ++collapsed;
+        // faces of the removed pair lost a coface, so they may have
+        // become free
+        for (auto const face : boundary_faces(*coface)) {
+            if (face != cell) {
+                candidates.push_back(face);
+            }
+        }
+        for (auto const face : boundary_faces(cell)) {
+            candidates.push_back(face);
+        }
+    }
+    return collapsed;
+}
+
+BitmapCubicalComplex::AxisStrides
+BitmapCubicalComplex::axis_strides(std::size_t cell, bool nontrivial) const {
+    std::array const coordinates = {
+        cell / m_strides[0],
+        cell / m_strides[1] % m_extents[1],
+        cell % m_extents[2],
+    };
+    AxisStrides result {};
+    for (std::size_t axis = 0; axis < coordinates.size(); ++axis) {
+        // even coordinates belong to nontrivial intervals
+        if ((coordinates[axis] % 2 == 0) == nontrivial) {
+            result.strides[result.count++] = m_strides[axis];
+        }
+    }
+    return result;
+}
+
+std::optional<std::size_t>
+BitmapCubicalComplex::unique_coface(std::size_t cell) const {
+    std::optional<std::size_t> coface = std::nullopt;
+    for (auto const candidate : coboundary_faces(cell)) {
+        if (!contains(candidate)) {
+            continue;
+        }
+        if (coface) {
+            return std::nullopt;
+        }
+        coface = candidate;
+    }
+    return coface;
+}
+
+} // namespace complexes
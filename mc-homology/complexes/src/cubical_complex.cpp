@@ -3,8 +3,12 @@
 #include <algorithm>
 #include <cassert>
 #include <compare>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <ranges>
+#include <span>
 #include <stdexcept>
-#include <unordered_set>
 #include <vector>
 
 #include "complexes/utils.h"
@@ -55,14 +59,20 @@ std::ostream& operator<<(std::ostream& output, BasicInterval i) {
     return output << std::format("{}", i);
 }
 
-CubicalSimplex::CubicalSimplex(std::vector<BasicInterval> intervals) :
-    m_intervals(std::move(intervals)),
-    m_dimension(std::ranges::count_if(m_intervals, [](BasicInterval const& i) {
-        return !i.is_trivial();
-    })) {
-    if (m_intervals.empty()) {
+CubicalSimplex::CubicalSimplex(std::span<BasicInterval const> intervals) {
+    if (intervals.empty()) {
         throw std::domain_error("Intervals cannot be empty");
     }
+    if (intervals.size() > max_ambient_dimension) {
+        throw std::domain_error("Too many intervals");
+    }
+    std::ranges::copy(intervals, m_intervals.begin());
+    m_ambient_dimension = static_cast<std::uint8_t>(intervals.size());
+    m_dimension = static_cast<std::uint8_t>(
+        std::ranges::count_if(intervals, [](BasicInterval const& i) {
+            return !i.is_trivial();
+        })
+    );
 }
 
 std::size_t CubicalSimplex::dimension() const {
@@ -70,33 +80,64 @@ std::size_t CubicalSimplex::dimension() const {
 }
 
 std::size_t CubicalSimplex::ambient_dimension() const {
-    return m_intervals.size();
+    return m_ambient_dimension;
 }
 
 std::size_t CubicalSimplex::hash() const {
-    return utils::hash_range(m_intervals);
+    std::uint64_t hash = m_ambient_dimension;
+    for (auto const& i : intervals()) {
+        auto const left = static_cast<std::uint32_t>(i.left());
+        hash = utils::mix_hash(
+            hash ^ (std::uint64_t {left} << 1 | !i.is_trivial())
+        );
+    }
+    return static_cast<std::size_t>(hash);
 }
 
 std::vector<CubicalSimplex> CubicalSimplex::boundary() const {
-    namespace vs = std::views;
-    std::vector<CubicalSimplex> boundary {};
-    for (auto const& [n, i] : m_intervals | vs::enumerate) {
+    return std::ranges::to<std::vector<CubicalSimplex>>(boundary_faces());
+}
+
+CubicalSimplex CubicalSimplex::boundary_face(std::size_t k) const {
+    auto face = *this;
+    auto nontrivial = k / 2;
+    for (auto& i : face.m_intervals | std::views::take(m_ambient_dimension)) {
+        if (i.is_trivial()) {
+            continue;
+        }
+        if (nontrivial-- == 0) {
+            i = BasicInterval::point(k % 2 == 0 ? i.right() : i.left());
+            --face.m_dimension;
+            return face;
+        }
+    }
+    throw std::out_of_range("Face index out of range");
+}
+
+std::vector<CubicalSimplex> CubicalSimplex::coboundary() const {
+    return std::ranges::to<std::vector<CubicalSimplex>>(coboundary_faces());
+}
+
+CubicalSimplex CubicalSimplex::coboundary_face(std::size_t k) const {
+    auto coface = *this;
+    auto trivial = k / 2;
+    for (auto& i : coface.m_intervals | std::views::take(m_ambient_dimension)) {
         if (!i.is_trivial()) {
-            auto top_boundary = m_intervals;
-            top_boundary[n] = BasicInterval::point(i.right());
-            auto bottom_boundary = m_intervals;
-            bottom_boundary[n] = BasicInterval::point(i.left());
-            boundary.emplace_back(std::move(top_boundary));
-            boundary.emplace_back(std::move(bottom_boundary));
+            continue;
+        }
+        if (trivial-- == 0) {
+            i = BasicInterval::interval(k % 2 == 0 ? i.left() - 1 : i.left());
+            ++coface.m_dimension;
+            return coface;
         }
     }
-    return boundary;
+    throw std::out_of_range("Coface index out of range");
 }
 
 bool CubicalSimplex::operator==(CubicalSimplex const&) const = default;
 
-std::vector<BasicInterval> const& CubicalSimplex::intervals() const {
-    return m_intervals;
+std::span<BasicInterval const> CubicalSimplex::intervals() const {
+    return std::span(m_intervals).first(m_ambient_dimension);
 }
 
 std::strong_ordering
@@ -105,11 +146,13 @@ CubicalSimplex::operator<=>(CubicalSimplex const& simplex) const {
     if (dim_ordering != std::strong_ordering::equal) {
         return dim_ordering;
     }
+    auto const lhs = intervals();
+    auto const rhs = simplex.intervals();
     return std::lexicographical_compare_three_way(
-        m_intervals.begin(),
-        m_intervals.end(),
-        simplex.m_intervals.begin(),
-        simplex.m_intervals.end(),
+        lhs.begin(),
+        lhs.end(),
+        rhs.begin(),
+        rhs.end(),
         [](BasicInterval i1, BasicInterval i2) {
             if (!i1.is_trivial() && i2.is_trivial()) {
                 return std::strong_ordering::less;
@@ -123,21 +166,26 @@ CubicalSimplex::operator<=>(CubicalSimplex const& simplex) const {
 }
 
 CubicalSimplex CubicalSimplex::point(int p) {
-    return CubicalSimplex(std::vector {BasicInterval::point(p)});
+    return CubicalSimplex(std::array {BasicInterval::point(p)});
 }
 
 CubicalSimplex CubicalSimplex::interval(int left) {
-    return CubicalSimplex(std::vector {BasicInterval::interval(left)});
+    return CubicalSimplex(std::array {BasicInterval::interval(left)});
 }
 
 CubicalSimplex::CubicalSimplex() = default;
 
 CubicalSimplex product(CubicalSimplex const& s1, CubicalSimplex const& s2) {
-    CubicalSimplex result {};
-    result.m_intervals = s1.m_intervals;
-    for (auto const& i : s2.m_intervals) {
-        result.m_intervals.push_back(i);
+    auto const ambient_dimension =
+        s1.ambient_dimension() + s2.ambient_dimension();
+    if (ambient_dimension > CubicalSimplex::max_ambient_dimension) {
+        throw std::domain_error("Too many intervals");
     }
+    CubicalSimplex result {};
+    auto const it =
+        std::ranges::copy(s1.intervals(), result.m_intervals.begin());
+    std::ranges::copy(s2.intervals(), it.out);
+    result.m_ambient_dimension = static_cast<std::uint8_t>(ambient_dimension);
     result.m_dimension = s1.m_dimension + s2.m_dimension;
     return result;
 }
@@ -157,34 +205,17 @@ bool CubicalComplex::add(CubicalSimplex simplex) {
     }
     auto dimension = simplex.dimension();
     if (dimension == 0) {
-        if (m_simplices.empty()) {
-            m_simplices.emplace_back(
-                std::unordered_set<CubicalSimplex> {std::move(simplex)}
-            );
-            return true;
-        } else {
-            auto [_, success] = m_simplices[0].emplace(std::move(simplex));
-            return success;
-        }
+        return insert(std::move(simplex));
     } else if (dimension > this->dimension() + 1) {
         return false;
     } else {
         if (std::ranges::all_of(
-                simplex.boundary(),
+                simplex.boundary_faces(),
                 [this](CubicalSimplex const& boundary_simplex) {
                     return this->contains(boundary_simplex);
                 }
             )) {
-            if (dimension == this->dimension() + 1) {
-                m_simplices.emplace_back(
-                    std::unordered_set<CubicalSimplex> {std::move(simplex)}
-                );
-                return true;
-            } else {
-                auto [_, success] =
-                    m_simplices[dimension].emplace(std::move(simplex));
-                return success;
-            }
+            return insert(std::move(simplex));
         } else {
             return false;
         }
@@ -207,40 +238,92 @@ void CubicalComplex::add_recursive(CubicalSimplex simplex) {
 bool CubicalComplex::remove(CubicalSimplex const& simplex) {
     if (simplex.dimension() > dimension()) {
         return false;
-    } else if (simplex.dimension() == dimension()) {
-        m_simplices[simplex.dimension()].erase(simplex);
-        if (m_simplices[simplex.dimension()].empty()) {
-            m_simplices.pop_back();
+    }
+    auto const* cell = m_cells.find_value(simplex);
+    if (cell && cell->coface_count != 0) {
+        return false;
+    }
+    erase(simplex);
+    while (!m_simplices.empty() && m_simplices.back().empty()) {
+        m_simplices.pop_back();
+    }
+    return true;
+}
+
+bool CubicalComplex::contains(CubicalSimplex const& simplex) const {
+    return m_cells.contains(simplex);
+}
+
+std::size_t CubicalComplex::collapse() {
+    std::deque<CubicalSimplex> candidates;
+    for (std::size_t dim = 0; dim < dimension(); ++dim) {
+        candidates.insert(
+            candidates.end(),
+            m_simplices[dim].begin(),
+            m_simplices[dim].end()
+        );
+    }
+    std::size_t collapsed = 0;
+    while (!candidates.empty()) {
+        auto simplex = std::move(candidates.front());
+        candidates.pop_front();
+        if (!contains(simplex)) {
+            continue;
         }
-        return true;
-    } else {
-        for (auto const& higher_dimensional_simplices :
-             m_simplices[simplex.dimension() + 1]) {
-            if (std::ranges::binary_search(
-                    higher_dimensional_simplices.boundary(),
-                    simplex
-                )) {
-                return false;
+        auto coface = unique_coface(simplex);
+        if (!coface) {
+            continue;
+        }
+        erase(*coface);
+        erase(simplex);
+        ++collapsed;
+        // faces of the removed pair lost a coface, so they may have
+        // become free
+        for (auto const& face : coface->boundary_faces()) {
+            if (face != simplex) {
+                candidates.push_back(face);
             }
         }
-        m_simplices[simplex.dimension()].erase(simplex);
-        return true;
+        for (auto const& face : simplex.boundary_faces()) {
+            candidates.push_back(face);
+        }
+    }
+    while (m_simplices.size() > 1 && m_simplices.back().empty()) {
+        m_simplices.pop_back();
     }
+    return collapsed;
 }
 
-bool CubicalComplex::contains(CubicalSimplex const& simplex) const {
-    return simplex.dimension() <= dimension()
-        ? m_simplices[simplex.dimension()].contains(simplex)
-        : false;
+bool CubicalComplex::operator==(CubicalComplex const& other) const {
+    if (m_simplices.size() != other.m_simplices.size()) {
+        return false;
+    }
+    for (std::size_t dim = 0; dim < m_simplices.size(); ++dim) {
+        if (m_simplices[dim].size() != other.m_simplices[dim].size()) {
+            return false;
+        }
+    }
+    // indices depend on the order of insertion, so only the simplices
+    // are compared
+    return std::ranges::all_of(m_cells, [&other](auto const& entry) {
+        return other.contains(entry.first);
+    });
 }
 
-bool CubicalComplex::operator==(CubicalComplex const&) const = default;
-
-std::vector<std::unordered_set<CubicalSimplex>> const&
+std::vector<std::vector<CubicalSimplex>> const&
 CubicalComplex::simplices() const {
     return m_simplices;
 }
 
+std::size_t CubicalComplex::index(CubicalSimplex const& simplex) const {
+    return m_cells.at(simplex).index;
+}
+
+std::size_t
+CubicalComplex::coface_count(CubicalSimplex const& simplex) const {
+    return m_cells.at(simplex).coface_count;
+}
+
 std::size_t CubicalComplex::dimension() const {
     if (m_simplices.empty()) {
         return 0;
@@ -253,17 +336,78 @@ std::size_t CubicalComplex::ambient_dimension() const {
         return 0;
     }
     assert(!m_simplices[0].empty());
-    return m_simplices[0].begin()->ambient_dimension();
+    return m_simplices[0].front().ambient_dimension();
 }
 
 void CubicalComplex::add_recursive_impl(CubicalSimplex simplex) {
+    if (!insert(simplex)) {
+        return;
+    }
+    for (auto const& face : simplex.boundary_faces()) {
+        add_recursive_impl(face);
+    }
+}
+
+bool CubicalComplex::insert(CubicalSimplex simplex) {
+    if (m_cells.contains(simplex)) {
+        return false;
+    }
     auto const dim = simplex.dimension();
-    auto [it, success] = m_simplices[dim].emplace(std::move(simplex));
-    if (success && dim != 0) {
-        for (auto simplex : it->boundary()) {
-            add_recursive_impl(std::move(simplex));
+    if (dim >= m_simplices.size()) {
+        m_simplices.resize(dim + 1);
+    }
+    // cofaces may be inserted before their faces by add_recursive
+    std::size_t coface_count = 0;
+    for (auto const& coface : simplex.coboundary_faces()) {
+        coface_count += m_cells.contains(coface);
+    }
+    for (auto const& face : simplex.boundary_faces()) {
+        if (auto* cell = m_cells.find_value(face)) {
+            ++cell->coface_count;
+        }
+    }
+    m_cells.emplace(
+        simplex,
+        Cell {.index = m_simplices[dim].size(), .coface_count = coface_count}
+    );
+    m_simplices[dim].push_back(std::move(simplex));
+    return true;
+}
+
+void CubicalComplex::erase(CubicalSimplex const& simplex) {
+    auto const* cell = m_cells.find_value(simplex);
+    if (!cell) {
+        return;
+    }
+    auto const index = cell->index;
+    for (auto const& face : simplex.boundary_faces()) {
+        if (auto* face_cell = m_cells.find_value(face)) {
+            --face_cell->coface_count;
+        }
+    }
+    auto& simplices = m_simplices[simplex.dimension()];
+    // the simplex may refer to an element of simplices, so it must not
+    // be used after they are modified
+    m_cells.erase(simplex);
+    if (index + 1 != simplices.size()) {
+        simplices[index] = std::move(simplices.back());
+        m_cells.at(simplices[index]).index = index;
+    }
+    simplices.pop_back();
+}
+
+std::optional<CubicalSimplex>
+CubicalComplex::unique_coface(CubicalSimplex const& simplex) const {
+    auto const* cell = m_cells.find_value(simplex);
+    if (!cell || cell->coface_count != 1) {
+        return std::nullopt;
+    }
+    for (auto const& candidate : simplex.coboundary_faces()) {
+        if (contains(candidate)) {
+            return candidate;
         }
     }
+    return std::nullopt;
 }
 
 } // namespace complexes
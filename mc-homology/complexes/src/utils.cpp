@@ -3,8 +3,19 @@
 namespace complexes {
 namespace utils {
 
+std::uint64_t mix_hash(std::uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111eb;
+    x ^= x >> 31;
+    return x;
+}
+
 std::size_t combine_hashes(std::size_t hash1, std::size_t hash2) {
-    return hash1 ^ (hash2 << 1);
+    return mix_hash(
+        hash1 ^ (hash2 + 0x9e3779b97f4a7c15 + (hash1 << 6) + (hash1 >> 2))
+    );
 }
 
 } // namespace utils
@@ -0,0 +1,142 @@
+#include "../include/complexes/voxel_columns.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+namespace complexes {
+
+VoxelColumns::VoxelColumns(VoxelGrid const& grid) {
+    constexpr int side = VoxelGrid::section_side;
+    // sections come sorted by x, then y, so every column receives its
+    // runs from the bottom
+    grid.for_each_section([this](Voxel section, auto const& voxels) {
+        for (int z = 0; z < side; ++z) {
+            for (int x = 0; x < side; ++x) {
+                // bit y of the mask is the voxel (x, y, z) of the section
+                std::uint32_t mask = 0;
+                for (int y = 0; y < side; ++y) {
+                    auto const word = voxels[y * 4 + z / 4];
+                    auto const bit = (word >> (z % 4 * 16 + x)) & 1;
+                    mask |= static_cast<std::uint32_t>(bit) << y;
+                }
+                while (mask != 0) {
+                    auto const begin = std::countr_zero(mask);
+                    auto const end = begin + std::countr_one(mask >> begin);
+                    append(
+                        side * section.x + x,
+                        side * section.z + z,
+                        {.begin = side * section.y + begin,
+                         .end = side * section.y + end}
+                    );
+                    mask &= ~std::uint32_t {0} << end;
+                }
+            }
+        }
+    });
+}
+
+void VoxelColumns::append(int x, int z, Run run) {
+    if (run.begin >= run.end) {
+        return;
+    }
+    auto& runs = m_columns[{x, z}];
+    if (!runs.empty() && run.begin < runs.back().end) [[unlikely]] {
+        throw std::invalid_argument("Runs have to be appended from below");
+    }
+    if (!runs.empty() && run.begin == runs.back().end) {
+        runs.back().end = run.end;
+    } else {
+        runs.push_back(run);
+    }
+}
+
+std::span<Run const> VoxelColumns::column(int x, int z) const {
+    auto const it = m_columns.find({x, z});
+    if (it == m_columns.end()) {
+        return {};
+    }
+    return it->second;
+}
+
+std::size_t VoxelColumns::column_count() const {
+    return m_columns.size();
+}
+
+std::size_t VoxelColumns::run_count() const {
+    std::size_t count = 0;
+    for (auto const& [column, runs] : m_columns) {
+        count += runs.size();
+    }
+    return count;
+}
+
+std::size_t VoxelColumns::size() const {
+    std::size_t size = 0;
+    for_each_run([&size](int, int, Run run) {
+        size += static_cast<std::size_t>(run.end - run.begin);
+    });
+    return size;
+}
+
+std::optional<std::pair<Voxel, Voxel>> VoxelColumns::bounding_box() const {
+    if (m_columns.empty()) {
+        return std::nullopt;
+    }
+    constexpr auto max = std::numeric_limits<int>::max();
+    constexpr auto min = std::numeric_limits<int>::min();
+    Voxel lower = {max, max, max};
+    Voxel upper = {min, min, min};
+    for (auto const& [column, runs] : m_columns) {
+        auto const [x, z] = column;
+        lower = {
+            std::min(lower.x, x),
+            std::min(lower.y, runs.front().begin),
+            std::min(lower.z, z),
+        };
+        upper = {
+            std::max(upper.x, x + 1),
+            std::max(upper.y, runs.back().end),
+            std::max(upper.z, z + 1),
+        };
+    }
+    return std::pair {lower, upper};
+}
+
+std::vector<int> VoxelColumns::breakpoints() const {
+    std::vector<int> breakpoints;
+    breakpoints.reserve(2 * run_count());
+    for_each_run([&breakpoints](int, int, Run run) {
+        breakpoints.push_back(run.begin);
+        breakpoints.push_back(run.end);
+    });
+    std::ranges::sort(breakpoints);
+    auto const [first, last] = std::ranges::unique(breakpoints);
+    breakpoints.erase(first, last);
+    return breakpoints;
+}
+
+VoxelColumns VoxelColumns::compress_y() const {
+    auto const breakpoints = this->breakpoints();
+    auto const squeeze = [&breakpoints](int y) {
+        return static_cast<int>(
+            std::ranges::lower_bound(breakpoints, y) - breakpoints.begin()
+        );
+    };
+    VoxelColumns compressed;
+    for (auto const& [column, runs] : m_columns) {
+        auto& squeezed = compressed.m_columns[column];
+        squeezed.reserve(runs.size());
+        for (auto const& run : runs) {
+            squeezed.push_back({
+                .begin = squeeze(run.begin),
+                .end = squeeze(run.end),
+            });
+        }
+    }
+    return compressed;
+}
+
+} // namespace complexes
@@ -0,0 +1,99 @@
+#include "../include/complexes/voxel_grid.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+using complexes::Voxel;
+using complexes::VoxelGrid;
+
+/// \brief Splits a voxel into its section and its index in the section
+std::pair<Voxel, std::size_t> locate(Voxel voxel) {
+    // arithmetic shifts round towards negative infinity
+    Voxel const section = {
+        .x = voxel.x >> 4,
+        .y = voxel.y >> 4,
+        .z = voxel.z >> 4,
+    };
+    auto const index = static_cast<std::size_t>(
+        ((voxel.y & 15) * 16 + (voxel.z & 15)) * 16 + (voxel.x & 15)
+    );
+    return {section, index};
+}
+
+} // namespace
+
+namespace complexes {
+
+void VoxelGrid::insert(Voxel voxel) {
+    auto const [section, index] = locate(voxel);
+    m_sections[section][index / 64] |= std::uint64_t {1} << (index % 64);
+}
+
+void VoxelGrid::insert_section(Voxel section, Section const& voxels) {
+    if (std::ranges::all_of(voxels, [](auto word) { return word == 0; })) {
+        return;
+    }
+    auto& stored = m_sections[section];
+    for (std::size_t word = 0; word < voxels.size(); ++word) {
+        stored[word] |= voxels[word];
+    }
+}
+
+bool VoxelGrid::contains(Voxel voxel) const {
+    auto const [section, index] = locate(voxel);
+    auto const it = m_sections.find(section);
+    return it != m_sections.end()
+        && (it->second[index / 64] >> (index % 64)) & 1;
+}
+
+bool VoxelGrid::empty() const {
+    return m_sections.empty();
+}
+
+std::size_t VoxelGrid::size() const {
+    std::size_t size = 0;
+    for (auto const& [section, voxels] : m_sections) {
+        for (auto word : voxels) {
+            size += static_cast<std::size_t>(std::popcount(word));
+        }
+    }
+    return size;
+}
+
+std::size_t VoxelGrid::section_count() const {
+    return m_sections.size();
+}
+
+std::optional<std::pair<Voxel, Voxel>> VoxelGrid::bounding_box() const {
+    if (empty()) {
+        return std::nullopt;
+    }
+    constexpr auto max = std::numeric_limits<int>::max();
+    constexpr auto min = std::numeric_limits<int>::min();
+    Voxel lower = {max, max, max};
+    Voxel upper = {min, min, min};
+    for_each([&](Voxel voxel) {
+        lower = {
+            std::min(lower.x, voxel.x),
+            std::min(lower.y, voxel.y),
+            std::min(lower.z, voxel.z),
+        };
+        upper = {
+            std::max(upper.x, voxel.x + 1),
+            std::max(upper.y, voxel.y + 1),
+            std::max(upper.z, voxel.z + 1),
+        };
+    });
+    return std::pair {lower, upper};
+}
+
+std::vector<Voxel> VoxelGrid::voxels() const {
+    std::vector<Voxel> voxels;
+    voxels.reserve(size());
+    for_each([&voxels](Voxel voxel) { voxels.push_back(voxel); });
+    return voxels;
+}
+
+} // namespace complexes
@@ -0,0 +1,244 @@
+#include "../include/complexes/voxel_homology.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using complexes::Voxel;
+
+/// \brief Occupancy of voxels in their bounding box padded by a layer
+///        of empty voxels
+class OccupancyGrid {
+public:
+    explicit OccupancyGrid(std::span<Voxel const> voxels) {
+        auto [min_x, max_x] = std::ranges::minmax(voxels, {}, &Voxel::x);
+        auto [min_y, max_y] = std::ranges::minmax(voxels, {}, &Voxel::y);
+        auto [min_z, max_z] = std::ranges::minmax(voxels, {}, &Voxel::z);
+        m_origin = {min_x.x - 1, min_y.y - 1, min_z.z - 1};
+        m_size = {
+            static_cast<long>(max_x.x) - min_x.x + 3,
+            static_cast<long>(max_y.y) - min_y.y + 3,
+            static_cast<long>(max_z.z) - min_z.z + 3,
+        };
+        m_occupied.resize(m_size[0] * m_size[1] * m_size[2]);
+        for (auto const& voxel : voxels) {
+            m_occupied[index(
+                voxel.x - m_origin.x,
+                voxel.y - m_origin.y,
+                voxel.z - m_origin.z
+            )] = true;
+        }
+    }
+
+    long size(std::size_t axis) const {
+        return m_size[axis];
+    }
+
+    bool operator()(long x, long y, long z) const {
+        return m_occupied[index(x, y, z)];
+    }
+
+private:
+    std::size_t index(long x, long y, long z) const {
+        return static_cast<std::size_t>((x * m_size[1] + y) * m_size[2] + z);
+    }
+
+    Voxel m_origin;
+    std::array<long, 3> m_size = {};
+    std::vector<bool> m_occupied;
+};
+
+/// \brief Disjoint sets with path halving and union by size
+class DisjointSets {
+public:
+    std::uint32_t make_set() {
+        m_parent.push_back(static_cast<std::uint32_t>(m_parent.size()));
+        m_size.push_back(1);
+        return m_parent.back();
+    }
+
+    std::uint32_t find(std::uint32_t x) {
+        while (m_parent[x] != x) {
+            m_parent[x] = m_parent[m_parent[x]];
+            x = m_parent[x];
+        }
+        return x;
+    }
+
+    /// \brief Returns true, if two different sets were merged
+    bool unite(std::uint32_t x, std::uint32_t y) {
+        x = find(x);
+        y = find(y);
+        if (x == y) {
+            return false;
+        }
+        if (m_size[x] < m_size[y]) {
+            std::swap(x, y);
+        }
+        m_parent[y] = x;
+        m_size[x] += m_size[y];
+        return true;
+    }
+
+private:
+    std::vector<std::uint32_t> m_parent;
+    std::vector<std::uint32_t> m_size;
+};
+
+using Offset = std::array<long, 3>;
+
+/// \brief Neighbours sharing at least a vertex, which precede a cell
+///        in the scan order
+constexpr auto vertex_neighbours = [] {
+    std::array<Offset, 13> offsets {};
+    std::size_t k = 0;
+    for (long dx = -1; dx <= 0; ++dx) {
+        for (long dy = -1; dy <= 1; ++dy) {
+            for (long dz = -1; dz <= 1; ++dz) {
+                if (dx == -1 || dy == -1 || (dy == 0 && dz == -1)) {
+                    offsets[k++] = {dx, dy, dz};
+                }
+            }
+        }
+    }
+    return offsets;
+}();
+
+/// \brief Neighbours sharing a face, which precede a cell in the scan
+///        order
+constexpr std::array<Offset, 3> face_neighbours = {{
+    {-1, 0, 0},
+    {0, -1, 0},
+    {0, 0, -1},
+}};
+
+/// \brief Counts connected components of cells with given occupancy
+///
+/// The grid is scanned slice by slice, keeping labels of only two
+/// slices. Every cell takes the label of its preceding neighbours,
+/// which are merged in a union-find structure.
+std::size_t count_components(
+    OccupancyGrid const& grid,
+    bool occupied,
+    std::span<Offset const> neighbours
+) {
+    constexpr auto none = std::numeric_limits<std::uint32_t>::max();
+    auto const nx = grid.size(0);
+    auto const ny = grid.size(1);
+    auto const nz = grid.size(2);
+    std::vector<std::uint32_t> previous(ny * nz, none);
+    std::vector<std::uint32_t> current(ny * nz, none);
+    DisjointSets sets;
+    std::size_t components = 0;
+    for (long x = 0; x < nx; ++x) {
+        for (long y = 0; y < ny; ++y) {
+            for (long z = 0; z < nz; ++z) {
+                auto& label = current[y * nz + z];
+                label = none;
+                if (grid(x, y, z) != occupied) {
+                    continue;
+                }
+                for (auto const& [dx, dy, dz] : neighbours) {
+                    auto const neighbour_y = y + dy;
+                    auto const neighbour_z = z + dz;
+                    if (x + dx < 0 || neighbour_y < 0 || neighbour_y >= ny
+                        || neighbour_z < 0 || neighbour_z >= nz) {
+                        continue;
+                    }
+                    auto const& slice = dx < 0 ? previous : current;
+                    auto const neighbour =
+                        slice[neighbour_y * nz + neighbour_z];
+                    if (neighbour == none) {
+                        continue;
+                    }
+                    if (label == none) {
+                        label = neighbour;
+                    } else if (sets.unite(label, neighbour)) {
+                        --components;
+                    }
+                }
+                if (label == none) {
+                    label = sets.make_set();
+                    ++components;
+                }
+            }
+        }
+        previous.swap(current);
+    }
+    return components;
+}
+
+/// \brief Euler characteristic of cells having the lattice point as
+///        their lowest vertex, indexed by occupancy of the 8 voxels
+///        around the point
+///
+/// Bit ((dx + 1) << 2) | ((dy + 1) << 1) | (dz + 1) of the index is
+/// set, if the voxel at offset (dx, dy, dz) from the point is occupied,
+/// where dx, dy, dz are -1 or 0.
+constexpr auto euler_contributions = [] {
+    std::array<int, 256> table {};
+    auto const any = [](unsigned config, std::initializer_list<int> bits) {
+        return std::ranges::any_of(bits, [config](int bit) {
+            return (config >> bit) & 1u;
+        });
+    };
+    for (unsigned config = 1; config < table.size(); ++config) {
+        int const vertices = 1;
+        int const edges = any(config, {4, 5, 6, 7})
+            + any(config, {2, 3, 6, 7}) + any(config, {1, 3, 5, 7});
+        int const faces =
+            any(config, {6, 7}) + any(config, {5, 7}) + any(config, {3, 7});
+        int const cubes = any(config, {7});
+        table[config] = vertices - edges + faces - cubes;
+    }
+    return table;
+}();
+
+/// \brief Computes the Euler characteristic of the union of voxels
+long long euler_characteristic(OccupancyGrid const& grid) {
+    long long chi = 0;
+    for (long x = 1; x < grid.size(0); ++x) {
+        for (long y = 1; y < grid.size(1); ++y) {
+            for (long z = 1; z < grid.size(2); ++z) {
+                unsigned config = 0;
+                for (unsigned bit = 0; bit < 8; ++bit) {
+                    long const dx = static_cast<long>(bit >> 2) - 1;
+                    long const dy = static_cast<long>((bit >> 1) & 1u) - 1;
+                    long const dz = static_cast<long>(bit & 1u) - 1;
+                    if (grid(x + dx, y + dy, z + dz)) {
+                        config |= 1u << bit;
+                    }
+                }
+                chi += euler_contributions[config];
+            }
+        }
+    }
+    return chi;
+}
+
+} // namespace
+
+namespace complexes {
+
+std::vector<std::size_t> voxel_betti_numbers(std::span<Voxel const> voxels) {
+    if (voxels.empty()) {
+        return {};
+    }
+    OccupancyGrid const grid(voxels);
+    auto const b0 = count_components(grid, true, vertex_neighbours);
+    // the padding makes the unbounded component of the complement
+    // connected, so it is counted exactly once
+    auto const b2 = count_components(grid, false, face_neighbours) - 1;
+    auto const chi = euler_characteristic(grid);
+    auto const b1 = static_cast<long long>(b0 + b2) - chi;
+    return {b0, static_cast<std::size_t>(b1), b2, 0};
+}
+
+} // namespace complexes
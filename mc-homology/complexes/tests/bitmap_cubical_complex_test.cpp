@@ -0,0 +1,138 @@
+#include "complexes/bitmap_cubical_complex.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <ranges>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "algebra/chain_complex.h"
+#include "algebra/integer.h"
+#include "algebra/z2_field.h"
+#include "complexes/compute_chain_complex.h"
+#include "complexes/cubical_complex.h"
+
+using namespace complexes;
+
+namespace {
+
+std::vector<Voxel> random_voxels() {
+    std::vector<Voxel> voxels;
+    std::uint64_t state = 0x2545f4914f6cdd1d;
+    for (int x = -2; x < 3; ++x) {
+        for (int y = 0; y < 4; ++y) {
+            for (int z = 1; z < 5; ++z) {
+                state = state * 6364136223846793005 + 1442695040888963407;
+                if ((state >> 61) < 4) {
+                    voxels.push_back({x, y, z});
+                }
+            }
+        }
+    }
+    return voxels;
+}
+
+template<class T>
+algebra::Homology<T> matrix_homology(std::vector<Voxel> const& voxels) {
+    CubicalComplex complex;
+    for (auto const& [x, y, z] : voxels) {
+        complex.add_recursive(product(
+            product(CubicalSimplex::interval(x), CubicalSimplex::interval(y)),
+            CubicalSimplex::interval(z)
+        ));
+    }
+    return algebra::homology(compute_chain_complex<T>(complex));
+}
+
+template<class T>
+algebra::Homology<T> bitmap_homology(
+    std::vector<Voxel> const& voxels,
+    bool collapse = false
+) {
+    BitmapCubicalComplex complex({-2, 0, 1}, {3, 4, 5});
+    for (auto const& voxel : voxels) {
+        complex.add_cube(voxel);
+    }
+    if (collapse) {
+        complex.collapse();
+    }
+    return algebra::homology(compute_chain_complex<T>(complex));
+}
+
+} // namespace
+
+TEST(BitmapCubicalComplexTest, Basics) {
+    BitmapCubicalComplex empty({0, 0, 0}, {0, 0, 0});
+    EXPECT_EQ(empty.size(), 27);
+    EXPECT_EQ(
+        std::ranges::count_if(
+            std::views::iota(std::size_t {0}, empty.size()),
+            [&](std::size_t cell) { return empty.contains(cell); }
+        ),
+        0
+    );
+    EXPECT_THROW(
+        BitmapCubicalComplex({0, 0, 0}, {1, -1, 1}),
+        std::domain_error
+    );
+
+    BitmapCubicalComplex cube({0, 0, 0}, {1, 1, 1});
+    EXPECT_THROW(cube.add_cube({1, 0, 0}), std::out_of_range);
+    cube.add_cube({0, 0, 0});
+    std::vector<std::size_t> counts(4);
+    for (std::size_t cell = 0; cell < cube.size(); ++cell) {
+        if (cube.contains(cell)) {
+            ++counts[cube.dimension(cell)];
+            EXPECT_EQ(
+                std::ranges::distance(cube.boundary_faces(cell)),
+                2 * cube.dimension(cell)
+            );
+            for (auto const face : cube.boundary_faces(cell)) {
+                EXPECT_TRUE(cube.contains(face));
+                EXPECT_EQ(cube.dimension(face) + 1, cube.dimension(cell));
+                EXPECT_EQ(
+                    std::ranges::count(cube.coboundary_faces(face), cell),
+                    1
+                );
+            }
+        }
+    }
+    EXPECT_EQ(counts, (std::vector<std::size_t> {8, 12, 6, 1}));
+}
+
+TEST(BitmapCubicalComplexTest, AgreesWithCubicalComplex) {
+    auto const voxels = random_voxels();
+    auto const z2 = matrix_homology<algebra::Z2>(voxels);
+    auto const z = matrix_homology<algebra::Integer>(voxels);
+    auto const bitmap_z2 = bitmap_homology<algebra::Z2>(voxels);
+    auto const bitmap_z = bitmap_homology<algebra::Integer>(voxels);
+    EXPECT_EQ(bitmap_z2.betti_numbers, z2.betti_numbers);
+    EXPECT_EQ(bitmap_z.betti_numbers, z.betti_numbers);
+    EXPECT_EQ(bitmap_z.torsion, z.torsion);
+    EXPECT_TRUE(bitmap_homology<algebra::Z2>({}).betti_numbers.empty());
+}
+
+TEST(BitmapCubicalComplexTest, Collapse) {
+    auto const voxels = random_voxels();
+    auto const expected = matrix_homology<algebra::Z2>(voxels);
+    auto const collapsed = bitmap_homology<algebra::Z2>(voxels, true);
+    // collapses may lower the dimension of the complex
+    auto betti_numbers = collapsed.betti_numbers;
+    betti_numbers.resize(expected.betti_numbers.size());
+    EXPECT_EQ(betti_numbers, expected.betti_numbers);
+
+    BitmapCubicalComplex solid({0, 0, 0}, {3, 3, 3});
+    for (int x = 0; x < 3; ++x) {
+        for (int y = 0; y < 3; ++y) {
+            for (int z = 0; z < 3; ++z) {
+                solid.add_cube({x, y, z});
+            }
+        }
+    }
+    solid.collapse();
+    auto const chain = compute_chain_complex<algebra::Z2>(solid);
+    EXPECT_EQ(chain.boundaries().size(), 1);
+    EXPECT_EQ(chain.boundaries()[0].ncols(), 1);
+}
@@ -3,10 +3,55 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <stdexcept>
 #include <vector>
 
 using namespace complexes;
 
+namespace {
+
+/// \brief Simplices of a complex sorted in every dimension
+std::vector<std::vector<CubicalSimplex>>
+sorted_simplices(std::vector<std::vector<CubicalSimplex>> simplices) {
+    for (auto& s : simplices) {
+        std::ranges::sort(s);
+    }
+    return simplices;
+}
+
+/// \brief Checks, that indices of simplices match their positions
+bool has_consistent_indices(CubicalComplex const& complex) {
+    for (auto const& simplices : complex.simplices()) {
+        for (std::size_t i = 0; i < simplices.size(); ++i) {
+            if (complex.index(simplices[i]) != i) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/// \brief Checks maintained numbers of cofaces against the boundaries
+bool has_consistent_coface_counts(CubicalComplex const& complex) {
+    auto const& simplices = complex.simplices();
+    for (std::size_t dim = 0; dim < simplices.size(); ++dim) {
+        for (auto const& simplex : simplices[dim]) {
+            std::size_t count = 0;
+            if (dim + 1 < simplices.size()) {
+                for (auto const& coface : simplices[dim + 1]) {
+                    count += std::ranges::count(coface.boundary(), simplex);
+                }
+            }
+            if (complex.coface_count(simplex) != count) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace
+
 TEST(BasicIntervalTest, Basics) {
     auto a = BasicInterval::point(0);
     auto b = BasicInterval::point(1);
@@ -94,6 +139,24 @@ TEST(CubicalSimplexTest, Boundary) {
     });
 }
 
+TEST(CubicalSimplexTest, Coboundary) {
+    auto point = CubicalSimplex::point(0);
+    auto edge = product(CubicalSimplex::interval(0), CubicalSimplex::point(0));
+    std::vector expected_coboundary_point {
+        CubicalSimplex::interval(-1),
+        CubicalSimplex::interval(0),
+    };
+    std::vector expected_coboundary_edge {
+        product(CubicalSimplex::interval(0), CubicalSimplex::interval(-1)),
+        product(CubicalSimplex::interval(0), CubicalSimplex::interval(0)),
+    };
+    EXPECT_EQ(point.coboundary(), expected_coboundary_point);
+    EXPECT_EQ(edge.coboundary(), expected_coboundary_edge);
+    for (auto const& coface : edge.coboundary()) {
+        EXPECT_EQ(std::ranges::count(coface.boundary(), edge), 1);
+    }
+}
+
 TEST(CubicalSimplexTest, Product) {
     auto p = CubicalSimplex::point(0);
     auto l = CubicalSimplex::interval(0);
@@ -114,6 +177,22 @@ TEST(CubicalSimplexTest, Product) {
     EXPECT_EQ(ll.dimension(), 2);
     EXPECT_EQ(ll.ambient_dimension(), 2);
     EXPECT_NE(pl, lp);
+    auto cube = product(ll, l);
+    EXPECT_EQ(cube.ambient_dimension(), 3);
+    EXPECT_EQ(cube.intervals().size(), 3);
+    EXPECT_THROW(product(cube, p), std::domain_error);
+}
+
+TEST(CubicalSimplexTest, FaceViews) {
+    auto l = CubicalSimplex::interval(0);
+    auto p = CubicalSimplex::point(0);
+    for (auto const& simplex :
+         {product(product(l, l), l), product(product(l, p), p)}) {
+        auto faces = simplex.boundary_faces();
+        auto cofaces = simplex.coboundary_faces();
+        EXPECT_TRUE(std::ranges::equal(faces, simplex.boundary()));
+        EXPECT_TRUE(std::ranges::equal(cofaces, simplex.coboundary()));
+    }
 }
 
 TEST(CubicalComplexTest, Basics) {
@@ -145,18 +224,76 @@ TEST(CubicalComplexTest, Basics) {
 
     complex2.add_recursive(sq);
 
-    auto simplices = std::vector {
-        std::unordered_set {p00, p01, p10, p11},
-        std::unordered_set {l0001, l1011, l0010, l0111},
-        std::unordered_set {sq},
-    };
+    auto simplices = sorted_simplices({
+        {p00, p01, p10, p11},
+        {l0001, l1011, l0010, l0111},
+        {sq},
+    });
 
     EXPECT_EQ(complex1, complex2);
-    EXPECT_EQ(complex1.simplices(), simplices);
+    EXPECT_EQ(sorted_simplices(complex1.simplices()), simplices);
+    EXPECT_TRUE(has_consistent_indices(complex1));
+    EXPECT_TRUE(has_consistent_indices(complex2));
+    EXPECT_TRUE(has_consistent_coface_counts(complex1));
+    EXPECT_TRUE(has_consistent_coface_counts(complex2));
+    EXPECT_EQ(complex2.coface_count(p00), 2);
+    EXPECT_EQ(complex2.coface_count(l0001), 1);
+    EXPECT_EQ(complex2.coface_count(sq), 0);
 
     complex2.remove(sq);
     simplices.pop_back();
 
     EXPECT_EQ(complex2, complex3);
-    EXPECT_EQ(complex3.simplices(), simplices);
+    EXPECT_EQ(sorted_simplices(complex3.simplices()), simplices);
+
+    EXPECT_TRUE(complex3.remove(l0001));
+    EXPECT_FALSE(complex3.remove(p00));
+    EXPECT_TRUE(complex3.remove(l0010));
+    EXPECT_TRUE(complex3.remove(p00));
+    EXPECT_FALSE(complex3.contains(p00));
+    EXPECT_EQ(complex3.simplices()[0].size(), 3);
+    EXPECT_TRUE(has_consistent_indices(complex3));
+    EXPECT_TRUE(has_consistent_coface_counts(complex3));
+    EXPECT_THROW(complex3.index(p00), std::out_of_range);
+}
+
+TEST(CubicalComplexTest, Collapse) {
+    auto const cube = [](int x, int y, int z) {
+        return product(
+            product(CubicalSimplex::interval(x), CubicalSimplex::interval(y)),
+            CubicalSimplex::interval(z)
+        );
+    };
+    auto const square = [](int x, int y) {
+        return product(
+            CubicalSimplex::interval(x),
+            CubicalSimplex::interval(y)
+        );
+    };
+
+    CubicalComplex solid;
+    for (int x = 0; x < 3; ++x) {
+        for (int y = 0; y < 3; ++y) {
+            for (int z = 0; z < 3; ++z) {
+                solid.add_recursive(cube(x, y, z));
+            }
+        }
+    }
+    EXPECT_GT(solid.collapse(), 0);
+    EXPECT_EQ(solid.dimension(), 0);
+    EXPECT_EQ(solid.simplices()[0].size(), 1);
+
+    CubicalComplex ring;
+    for (int x = 0; x < 3; ++x) {
+        for (int y = 0; y < 3; ++y) {
+            if (x != 1 || y != 1) {
+                ring.add_recursive(square(x, y));
+            }
+        }
+    }
+    ring.collapse();
+    EXPECT_EQ(ring.dimension(), 1);
+    EXPECT_EQ(ring.simplices()[0].size(), ring.simplices()[1].size());
+    EXPECT_EQ(ring.collapse(), 0);
+    EXPECT_TRUE(has_consistent_coface_counts(ring));
 }
@@ -0,0 +1,54 @@
+#include "complexes/flat_hash_map.h"
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+using namespace complexes;
+
+TEST(FlatHashMapTest, Basics) {
+    FlatHashMap<std::string, int> map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_THROW(map.at("a"), std::out_of_range);
+
+    auto [it, inserted] = map.emplace("a", 1);
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(it->first, "a");
+    EXPECT_EQ(it->second, 1);
+    EXPECT_FALSE(map.emplace("a", 2).second);
+    EXPECT_EQ(map.at("a"), 1);
+    map.at("a") = 3;
+    EXPECT_EQ(map.at("a"), 3);
+    *map.find_value("a") += 1;
+    EXPECT_EQ(map.at("a"), 4);
+    EXPECT_EQ(map.find_value("b"), nullptr);
+    EXPECT_EQ(map.erase("a"), 1);
+    EXPECT_FALSE(map.contains("a"));
+}
+
+TEST(FlatHashMapTest, AgreesWithUnorderedMap) {
+    FlatHashMap<int, int> map;
+    std::unordered_map<int, int> expected;
+    for (int i = 0; i < 1000; ++i) {
+        int const key = (i * 7919) % 211;
+        if (i % 4 == 3) {
+            EXPECT_EQ(map.erase(key), expected.erase(key));
+        } else if (map.contains(key)) {
+            map.at(key) += i;
+            expected.at(key) += i;
+        } else {
+            map.emplace(key, i);
+            expected.emplace(key, i);
+        }
+        ASSERT_EQ(map.size(), expected.size());
+    }
+    for (auto const& [key, value] : expected) {
+        EXPECT_EQ(map.at(key), value);
+    }
+    FlatHashMap<int, int> copy = map;
+    EXPECT_EQ(copy, map);
+    copy.at(copy.begin()->first) += 1;
+    EXPECT_NE(copy, map);
+}
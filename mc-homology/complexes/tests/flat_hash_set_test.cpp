@@ -0,0 +1,76 @@
+#include "complexes/flat_hash_set.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <ranges>
+#include <unordered_set>
+#include <vector>
+
+using namespace complexes;
+
+namespace {
+
+/// \brief A hash sending all values to few slots, so that probe
+///        sequences overlap
+struct CollidingHash {
+    std::size_t operator()(int x) const {
+        return static_cast<std::size_t>(x % 3);
+    }
+};
+
+} // namespace
+
+TEST(FlatHashSetTest, Basics) {
+    FlatHashSet<int> set;
+    EXPECT_TRUE(set.empty());
+    EXPECT_FALSE(set.contains(0));
+    EXPECT_EQ(set.find(0), set.end());
+    EXPECT_EQ(set.erase(0), 0);
+
+    auto [it, inserted] = set.insert(5);
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(*it, 5);
+    auto [it2, inserted2] = set.emplace(5);
+    EXPECT_FALSE(inserted2);
+    EXPECT_EQ(it2, it);
+    EXPECT_EQ(set.size(), 1);
+    EXPECT_TRUE(set.contains(5));
+    EXPECT_EQ(set.erase(5), 1);
+    EXPECT_TRUE(set.empty());
+    EXPECT_FALSE(set.contains(5));
+}
+
+TEST(FlatHashSetTest, Equality) {
+    FlatHashSet a {1, 2, 3};
+    FlatHashSet b {3, 2, 1, 2};
+    FlatHashSet c {1, 2};
+    EXPECT_EQ(a, b);
+    EXPECT_NE(a, c);
+    c.insert(3);
+    EXPECT_EQ(a, c);
+    static_assert(std::ranges::forward_range<FlatHashSet<int>>);
+}
+
+TEST(FlatHashSetTest, AgreesWithUnorderedSet) {
+    FlatHashSet<int, CollidingHash> set;
+    std::unordered_set<int> expected;
+    for (int i = 0; i < 1000; ++i) {
+        int const value = (i * 7919) % 503;
+        if (i % 3 == 2) {
+            EXPECT_EQ(set.erase(value), expected.erase(value));
+        } else {
+            EXPECT_EQ(set.insert(value).second, expected.insert(value).second);
+        }
+        ASSERT_EQ(set.size(), expected.size());
+    }
+    for (int value = 0; value < 503; ++value) {
+        EXPECT_EQ(set.contains(value), expected.contains(value));
+    }
+    std::vector<int> elements(set.begin(), set.end());
+    std::ranges::sort(elements);
+    std::vector<int> expected_elements(expected.begin(), expected.end());
+    std::ranges::sort(expected_elements);
+    EXPECT_EQ(elements, expected_elements);
+}
@@ -0,0 +1,89 @@
+#include "complexes/voxel_columns.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include "complexes/voxel_grid.h"
+#include "complexes/voxel_homology.h"
+
+using namespace complexes;
+
+namespace {
+
+std::vector<Voxel> voxels(VoxelColumns const& columns) {
+    std::vector<Voxel> voxels;
+    columns.for_each_run([&voxels](int x, int z, Run run) {
+        for (int y = run.begin; y < run.end; ++y) {
+            voxels.push_back({x, y, z});
+        }
+    });
+    return voxels;
+}
+
+} // namespace
+
+TEST(VoxelColumnsTest, FromGrid) {
+    VoxelGrid grid;
+    // a run crossing the boundary of two sections
+    for (int y = -20; y < 40; ++y) {
+        grid.insert({-1, y, 3});
+    }
+    grid.insert({-1, 41, 3});
+    grid.insert({5, 0, -7});
+    VoxelColumns const columns(grid);
+    EXPECT_EQ(columns.column_count(), 2);
+    EXPECT_EQ(columns.run_count(), 3);
+    EXPECT_EQ(columns.size(), grid.size());
+    std::vector<complexes::Run> const expected = {{-20, 40}, {41, 42}};
+    EXPECT_TRUE(std::ranges::equal(columns.column(-1, 3), expected));
+    EXPECT_EQ(columns.column(5, -7).size(), 1);
+    EXPECT_TRUE(columns.column(0, 0).empty());
+    auto const box = columns.bounding_box();
+    ASSERT_TRUE(box.has_value());
+    EXPECT_EQ(box, grid.bounding_box());
+}
+
+TEST(VoxelColumnsTest, Append) {
+    VoxelColumns columns;
+    columns.append(0, 0, {0, 2});
+    columns.append(0, 0, {2, 4});
+    columns.append(0, 0, {5, 5});
+    EXPECT_EQ(columns.run_count(), 1);
+    EXPECT_THROW(columns.append(0, 0, {3, 6}), std::invalid_argument);
+    EXPECT_FALSE(VoxelColumns().bounding_box().has_value());
+}
+
+TEST(VoxelColumnsTest, CompressY) {
+    VoxelColumns columns;
+    // a hollow cube standing on a tall pillar
+    for (int x = 0; x < 3; ++x) {
+        for (int z = 0; z < 3; ++z) {
+            if (x == 1 && z == 1) {
+                columns.append(x, z, {-64, 101});
+                columns.append(x, z, {102, 103});
+            } else {
+                columns.append(x, z, {100, 103});
+            }
+        }
+    }
+    columns.append(1, 1, {300, 320});
+    EXPECT_EQ(
+        columns.breakpoints(),
+        (std::vector<int> {-64, 100, 101, 102, 103, 300, 320})
+    );
+    auto const compressed = columns.compress_y();
+    std::vector<complexes::Run> const expected = {{0, 2}, {3, 4}, {5, 6}};
+    EXPECT_TRUE(std::ranges::equal(compressed.column(1, 1), expected));
+    EXPECT_EQ(compressed.compress_y(), compressed);
+    EXPECT_EQ(
+        voxel_betti_numbers(voxels(compressed)),
+        voxel_betti_numbers(voxels(columns))
+    );
+    EXPECT_EQ(
+        voxel_betti_numbers(voxels(compressed)),
+        (std::vector<std::size_t> {2, 0, 1, 0})
+    );
+}
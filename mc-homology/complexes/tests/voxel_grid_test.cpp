@@ -0,0 +1,73 @@
+#include "complexes/voxel_grid.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+using namespace complexes;
+
+TEST(VoxelGridTest, Empty) {
+    VoxelGrid grid;
+    EXPECT_TRUE(grid.empty());
+    EXPECT_EQ(grid.size(), 0);
+    EXPECT_FALSE(grid.bounding_box().has_value());
+    EXPECT_TRUE(grid.voxels().empty());
+    // an empty section isn't stored
+    grid.insert_section({0, 0, 0}, {});
+    EXPECT_EQ(grid.section_count(), 0);
+}
+
+TEST(VoxelGridTest, Insert) {
+    VoxelGrid grid;
+    grid.insert({-1, 0, 17});
+    grid.insert({-1, 0, 17});
+    grid.insert({15, -16, 0});
+    EXPECT_EQ(grid.size(), 2);
+    EXPECT_EQ(grid.section_count(), 2);
+    EXPECT_TRUE(grid.contains({-1, 0, 17}));
+    EXPECT_TRUE(grid.contains({15, -16, 0}));
+    EXPECT_FALSE(grid.contains({-1, 0, 16}));
+    EXPECT_FALSE(grid.contains({15, 0, 0}));
+    EXPECT_FALSE(grid.contains({-17, 0, 17}));
+    auto const box = grid.bounding_box();
+    ASSERT_TRUE(box.has_value());
+    EXPECT_EQ(box->first, (Voxel {-1, -16, 0}));
+    EXPECT_EQ(box->second, (Voxel {16, 1, 18}));
+}
+
+TEST(VoxelGridTest, InsertSection) {
+    VoxelGrid::Section section = {};
+    // (0, 0, 0), (1, 0, 0) and (2, 1, 3)
+    section[0] = 0b11;
+    section[(256 + 3 * 16 + 2) / 64] |= std::uint64_t {1} << (3 * 16 + 2);
+    VoxelGrid grid;
+    grid.insert({0, 0, 0});
+    grid.insert({-14, 32, 5});
+    grid.insert_section({-1, 2, 0}, section);
+    EXPECT_EQ(grid.size(), 5);
+    EXPECT_EQ(grid.section_count(), 2);
+    EXPECT_TRUE(grid.contains({-16, 32, 0}));
+    EXPECT_TRUE(grid.contains({-15, 32, 0}));
+    EXPECT_TRUE(grid.contains({-14, 33, 3}));
+    // voxels are visited by sections, then by y, z and x
+    std::vector<Voxel> const expected = {
+        {-16, 32, 0},
+        {-15, 32, 0},
+        {-14, 32, 5},
+        {-14, 33, 3},
+        {0, 0, 0},
+    };
+    EXPECT_EQ(grid.voxels(), expected);
+}
+
+TEST(VoxelGridTest, Equality) {
+    VoxelGrid first;
+    VoxelGrid second;
+    first.insert({1, 2, 3});
+    first.insert({-40, 2, 3});
+    second.insert({-40, 2, 3});
+    EXPECT_NE(first, second);
+    second.insert({1, 2, 3});
+    EXPECT_EQ(first, second);
+}
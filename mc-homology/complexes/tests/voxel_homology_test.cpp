@@ -0,0 +1,73 @@
+#include "complexes/voxel_homology.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "algebra/chain_complex.h"
+#include "algebra/z2_field.h"
+#include "complexes/compute_chain_complex.h"
+#include "complexes/cubical_complex.h"
+
+using namespace complexes;
+
+namespace {
+
+std::vector<std::size_t>
+matrix_betti_numbers(std::vector<Voxel> const& voxels) {
+    CubicalComplex complex;
+    for (auto const& [x, y, z] : voxels) {
+        complex.add_recursive(product(
+            product(CubicalSimplex::interval(x), CubicalSimplex::interval(y)),
+            CubicalSimplex::interval(z)
+        ));
+    }
+    return algebra::homology(compute_chain_complex<algebra::Z2>(complex))
+        .betti_numbers;
+}
+
+} // namespace
+
+TEST(VoxelHomologyTest, Basics) {
+    std::vector<Voxel> cube = {{0, 0, 0}};
+    std::vector<Voxel> two_cubes = {{0, 0, 0}, {2, 0, 0}};
+    std::vector<Voxel> touching_cubes = {{0, 0, 0}, {1, 1, 1}};
+    std::vector<Voxel> ring;
+    std::vector<Voxel> shell;
+    for (int x = 0; x < 3; ++x) {
+        for (int y = 0; y < 3; ++y) {
+            if (x != 1 || y != 1) {
+                ring.push_back({x, y, 0});
+            }
+            for (int z = 0; z < 3; ++z) {
+                if (x != 1 || y != 1 || z != 1) {
+                    shell.push_back({x, y, z});
+                }
+            }
+        }
+    }
+    using Betti = std::vector<std::size_t>;
+    EXPECT_EQ(voxel_betti_numbers({}), Betti {});
+    EXPECT_EQ(voxel_betti_numbers(cube), (Betti {1, 0, 0, 0}));
+    EXPECT_EQ(voxel_betti_numbers(two_cubes), (Betti {2, 0, 0, 0}));
+    EXPECT_EQ(voxel_betti_numbers(touching_cubes), (Betti {1, 0, 0, 0}));
+    EXPECT_EQ(voxel_betti_numbers(ring), (Betti {1, 1, 0, 0}));
+    EXPECT_EQ(voxel_betti_numbers(shell), (Betti {1, 0, 1, 0}));
+}
+
+TEST(VoxelHomologyTest, AgreesWithMatrixHomology) {
+    std::vector<Voxel> voxels;
+    std::uint64_t state = 0x9e3779b97f4a7c15;
+    for (int x = 0; x < 5; ++x) {
+        for (int y = -2; y < 2; ++y) {
+            for (int z = 0; z < 4; ++z) {
+                state = state * 6364136223846793005 + 1442695040888963407;
+                if ((state >> 61) < 4) {
+                    voxels.push_back({x, y, z});
+                }
+            }
+        }
+    }
+    EXPECT_EQ(voxel_betti_numbers(voxels), matrix_betti_numbers(voxels));
+}
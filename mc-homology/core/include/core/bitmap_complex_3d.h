@@ -0,0 +1,67 @@
+/// \file bitmap_complex_3d.h
+/// \brief A file containing a concrete class BitmapComplex3D
+#pragma once
+
+#include "complexes/bitmap_cubical_complex.h"
+#include "complexes/compute_chain_complex.h"
+#include "complexes/voxel_homology.h"
+#include "core/algebra_homology.h"
+#include "core/complex.h"
+
+namespace core {
+
+/// \brief A class representing a cubical complex in a box of 3D space
+///
+/// Cells are stored in a bitmap over the box, so building the complex,
+/// collapsing it and assembling boundary matrices use array indexing
+/// instead of hash lookups.
+class BitmapComplex3D: public Complex {
+public:
+    /// \brief Constructs an empty complex in a box
+    ///
+    /// \param lower Lower corner of the box
+    /// \param upper Upper corner of the box, exclusive
+    BitmapComplex3D(complexes::Voxel lower, complexes::Voxel upper);
+
+    /// \brief Adds a cube to the complex
+    void add_cube(int x, int y, int z);
+
+    /// \brief Computes Z2 homology of the complex
+    std::unique_ptr<Homology> z2_homology() const override;
+
+    /// \brief Computes Z3 homology of the complex
+    std::unique_ptr<Homology> z3_homology() const override;
+
+    /// \brief Computes Zp homology of the complex
+    std::unique_ptr<Homology> zp_homology(std::uint64_t p) const override;
+
+    /// \brief Computes Z homology of the complex
+    std::unique_ptr<Homology> z_homology() const override;
+
+    /// \brief Computes homology of the complex for coefficients
+    ///        of type T
+    template<class T>
+    std::unique_ptr<AlgebraHomology<T>> homology() const {
+        auto homology =
+            algebra::homology(complexes::compute_chain_complex<T>(m_inner));
+        // collapses may lower the dimension of the complex, but the
+        // homology is always reported up to dimension 3
+        if (!homology.betti_numbers.empty()) {
+            homology.betti_numbers.resize(4);
+            homology.torsion.resize(4);
+        }
+        return std::make_unique<AlgebraHomology<T>>(std::move(homology));
+    }
+
+    /// \brief Decreases the complex's size without changing its
+    ///        homology
+    ///
+    /// The complex is reduced using elementary collapses.
+    void reduce() override;
+
+private:
+    /// \brief Inner representation of the cubical complex
+    complexes::BitmapCubicalComplex m_inner;
+};
+
+} // namespace core
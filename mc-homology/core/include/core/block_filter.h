@@ -0,0 +1,55 @@
+/// \file block_filter.h
+/// \brief A file containing a classification of blocks into solid and
+///        empty
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace core {
+
+/// \brief A class deciding, which blocks belong to the studied space
+class BlockFilter {
+public:
+    /// \brief Constructs a filter treating every block except air as
+    ///        solid
+    ///
+    /// Air includes cave air and void air, as in the game.
+    BlockFilter();
+
+    /// \brief Constructs a filter treating only listed blocks as solid
+    ///
+    /// Names without a namespace are taken from the `minecraft`
+    /// namespace, so "stone" and "minecraft:stone" are the same block.
+    /// An empty list gives the default filter.
+    ///
+    /// \param solid_blocks Names of solid blocks
+    explicit BlockFilter(std::vector<std::string> solid_blocks);
+
+    /// \brief Checks, whether a block is solid
+    ///
+    /// \param block Namespaced name of the block, as stored in block
+    ///        palettes
+    bool is_solid(std::string_view block) const;
+
+    /// \brief Checks, whether some kind of air is solid
+    ///
+    /// Heightmaps of chunks ignore air, so they bound solid blocks only
+    /// if air is empty.
+    bool has_solid_air() const;
+
+    /// \brief Returns a hash identifying the filter
+    ///
+    /// Filters treating the same blocks as solid have equal
+    /// fingerprints, which are stable across runs.
+    std::uint64_t fingerprint() const;
+
+private:
+    /// \brief Sorted namespaced names of solid blocks, empty if every
+    ///        block except air is solid
+    std::vector<std::string> m_solid_blocks;
+};
+
+} // namespace core
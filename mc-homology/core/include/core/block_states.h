@@ -0,0 +1,102 @@
+/// \file block_states.h
+/// \brief A file containing unpacking of block states of chunk sections
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace core {
+
+/// \brief Number of blocks in a chunk section
+constexpr std::size_t blocks_per_section = 16 * 16 * 16;
+
+/// \brief Occupancy of blocks of a section, one bit per block
+///
+/// Bit `i % 64` of word `i / 64` is set, iff block `i` is solid. Blocks
+/// are numbered in YZX order, as in the save file.
+using SectionOccupancy = std::array<std::uint64_t, blocks_per_section / 64>;
+
+/// \brief Occupancy of a section of a chunk
+struct OccupiedSection {
+    /// \brief y coordinate of the section, in sections
+    int y = 0;
+    /// \brief Occupancy of blocks of the section
+    SectionOccupancy blocks = {};
+};
+
+/// \brief Occupancy of a chunk, listing only non-empty sections
+using ChunkOccupancy = std::vector<OccupiedSection>;
+
+/// \brief Returns number of bits of a packed block state
+///
+/// \param palette_size Number of entries of the palette of the section
+unsigned bits_per_block(std::size_t palette_size);
+
+/// \brief Unpacks block states of a section into palette indices
+///
+/// Block states are packed into 64-bit integers, starting from the least
+/// significant bits, and an index never spans two integers, as in save
+/// files of version 1.16 and newer. Sections with a single palette entry
+/// may have no data, all of their indices are 0. On x86-64 processors
+/// supporting AVX2 every integer is unpacked with vector shifts.
+///
+/// Throws std::runtime_error, if the data is too short.
+///
+/// \param data Packed block states
+/// \param palette_size Number of entries of the palette of the section
+/// \param indices Palette indices of blocks in YZX order
+void unpack_block_states(
+    std::span<std::uint64_t const> data,
+    std::size_t palette_size,
+    std::span<std::uint16_t, blocks_per_section> indices
+);
+
+/// \brief Unpacks block states of a section directly into occupancy
+///
+/// Uses the same packing as unpack_block_states(). Blocks with indices
+/// outside of the palette are empty.
+///
+/// Throws std::runtime_error, if the data is too short.
+///
+/// \param data Packed block states
+/// \param solid Flags of solid palette entries
+///
+/// \return Occupancy of blocks of the section
+SectionOccupancy unpack_occupancy(
+    std::span<std::uint64_t const> data,
+    std::vector<bool> const& solid
+);
+
+namespace detail {
+
+/// \brief Scalar version of unpack_block_states()
+///
+/// Used on processors without AVX2 and by tests of both versions.
+void unpack_block_states_scalar(
+    std::span<std::uint64_t const> data,
+    std::size_t palette_size,
+    std::span<std::uint16_t, blocks_per_section> indices
+);
+
+/// \brief Scalar version of unpack_occupancy()
+///
+/// Used on processors without AVX2 and by tests of both versions.
+SectionOccupancy unpack_occupancy_scalar(
+    std::span<std::uint64_t const> data,
+    std::vector<bool> const& solid
+);
+
+} // namespace detail
+
+/// \brief Returns whether a block is solid
+///
+/// \param occupancy Occupancy of a section
+/// \param block Index of the block in YZX order
+inline bool is_occupied(SectionOccupancy const& occupancy, std::size_t block) {
+    return (occupancy[block / 64] >> (block % 64)) & 1;
+}
+
+} // namespace core
@@ -0,0 +1,103 @@
+/// \file bounded_queue.h
+/// \brief A file containing a blocking queue of limited capacity
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+namespace core {
+
+/// \brief A thread-safe FIFO queue connecting stages of a pipeline
+///
+/// Producers block while the queue is full, so a fast stage can't run
+/// arbitrarily far ahead of a slow one, and consumers block while it is
+/// empty. Closing the queue wakes everybody up: no more elements are
+/// accepted, and elements already in the queue can still be taken.
+///
+/// \tparam T Type of the elements
+template<class T>
+class BoundedQueue {
+public:
+    /// \brief Constructs an empty queue
+    ///
+    /// Throws std::invalid_argument, if the capacity is 0.
+    ///
+    /// \param capacity Maximal number of elements in the queue
+    explicit BoundedQueue(std::size_t capacity) :
+        m_capacity(capacity) {
+        if (capacity == 0) [[unlikely]] {
+            throw std::invalid_argument("Capacity has to be positive");
+        }
+    }
+
+    BoundedQueue(BoundedQueue const&) = delete;
+    BoundedQueue& operator=(BoundedQueue const&) = delete;
+
+    /// \brief Appends an element, waiting while the queue is full
+    ///
+    /// \return false if the queue has been closed and the element was
+    ///         dropped
+    bool push(T value) {
+        std::unique_lock lock(m_mutex);
+        m_not_full.wait(lock, [this] {
+            return m_closed || m_elements.size() < m_capacity;
+        });
+        if (m_closed) {
+            return false;
+        }
+        m_elements.push_back(std::move(value));
+        lock.unlock();
+        m_not_empty.notify_one();
+        return true;
+    }
+
+    /// \brief Takes the first element, waiting while the queue is empty
+    ///
+    /// \return The element, or nullopt if the queue has been closed and
+    ///         emptied
+    std::optional<T> pop() {
+        std::unique_lock lock(m_mutex);
+        m_not_empty.wait(lock, [this] {
+            return m_closed || !m_elements.empty();
+        });
+        if (m_elements.empty()) {
+            return std::nullopt;
+        }
+        std::optional<T> value = std::move(m_elements.front());
+        m_elements.pop_front();
+        lock.unlock();
+        m_not_full.notify_one();
+        return value;
+    }
+
+    /// \brief Closes the queue, which can be done repeatedly
+    void close() {
+        {
+            std::scoped_lock lock(m_mutex);
+            m_closed = true;
+        }
+        m_not_full.notify_all();
+        m_not_empty.notify_all();
+    }
+
+private:
+    /// \brief Maximal number of elements
+    std::size_t m_capacity;
+    /// \brief Elements in the order of pushing
+    std::deque<T> m_elements;
+    /// \brief Whether the queue has been closed
+    bool m_closed = false;
+    /// \brief Mutex guarding all the members
+    std::mutex m_mutex;
+    /// \brief Signalled when an element is taken
+    std::condition_variable m_not_full;
+    /// \brief Signalled when an element is appended
+    std::condition_variable m_not_empty;
+};
+
+} // namespace core
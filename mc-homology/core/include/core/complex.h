@@ -2,6 +2,7 @@
 /// \brief A file containing interface for the Complex class
 #pragma once
 
+#include <cstdint>
 #include <memory>
 
 #include "core/homology.h"
@@ -17,6 +18,11 @@ public:
     /// \brief Computes Z3 homology of the complex
     virtual std::unique_ptr<Homology> z3_homology() const = 0;
 
+    /// \brief Computes Zp homology of the complex
+    ///
+    /// \param p An odd prime below 2^63
+    virtual std::unique_ptr<Homology> zp_homology(std::uint64_t p) const = 0;
+
     /// \brief Computes Z homology of the complex
     virtual std::unique_ptr<Homology> z_homology() const = 0;
 
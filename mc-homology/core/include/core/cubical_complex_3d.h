@@ -21,6 +21,9 @@ public:
     /// \brief Computes Z3 homology of the complex
     std::unique_ptr<Homology> z3_homology() const override;
 
+    /// \brief Computes Zp homology of the complex
+    std::unique_ptr<Homology> zp_homology(std::uint64_t p) const override;
+
     /// \brief Computes Z homology of the complex
     std::unique_ptr<Homology> z_homology() const override;
 
@@ -28,13 +31,22 @@ public:
     ///        of type T
     template<class T>
     std::unique_ptr<AlgebraHomology<T>> homology() const {
-        return std::make_unique<AlgebraHomology<T>>(
-            algebra::homology(complexes::compute_chain_complex<T>(m_inner))
-        );
+        auto homology =
+            algebra::homology(complexes::compute_chain_complex<T>(m_inner));
+        // collapses may lower the dimension of the complex, but the
+        // homology is always reported up to dimension 3
+        if (!homology.betti_numbers.empty()) {
+            homology.betti_numbers.resize(4);
+            homology.torsion.resize(4);
+        }
+        return std::make_unique<AlgebraHomology<T>>(std::move(homology));
     }
 
     /// \brief Decreases the complex's size without changing its
     ///        homology
+    ///
+    /// The complex is reduced using elementary collapses, so a solid
+    /// build shrinks to a few critical cells.
     void reduce() override;
 
 private:
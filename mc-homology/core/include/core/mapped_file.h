@@ -0,0 +1,41 @@
+/// \file mapped_file.h
+/// \brief A file containing a read-only view of a file in memory
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+namespace core {
+
+/// \brief A read-only file mapped into memory
+///
+/// On POSIX systems the file is memory mapped, so only the touched
+/// pages are read, elsewhere it is read into a buffer.
+class MappedFile {
+public:
+    /// \brief Maps a file
+    ///
+    /// Throws std::runtime_error, if the file cannot be read.
+    explicit MappedFile(std::filesystem::path const& path);
+
+    MappedFile(MappedFile const&) = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+
+    /// \brief Unmaps the file
+    ~MappedFile();
+
+    /// \brief Contents of the file
+    std::span<std::byte const> data() const;
+
+private:
+    /// \brief Contents of the file
+    std::span<std::byte const> m_data;
+    /// \brief Address of the memory mapping, if the file is mapped
+    void* m_mapping = nullptr;
+    /// \brief Contents of the file, if it is not mapped
+    std::vector<std::byte> m_buffer;
+};
+
+} // namespace core
@@ -0,0 +1,164 @@
+/// \file nbt.h
+/// \brief A file containing a reader of NBT data viewed in place
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace core {
+
+/// \brief Types of NBT tags
+enum class NbtTag : std::uint8_t {
+    End = 0,
+    Byte = 1,
+    Short = 2,
+    Int = 3,
+    Long = 4,
+    Float = 5,
+    Double = 6,
+    ByteArray = 7,
+    String = 8,
+    List = 9,
+    Compound = 10,
+    IntArray = 11,
+    LongArray = 12,
+};
+
+class NbtView;
+
+/// \brief An iterator over elements of an NBT list
+class NbtListIterator {
+public:
+    using value_type = NbtView;
+    using difference_type = std::ptrdiff_t;
+
+    NbtListIterator() = default;
+
+    /// \brief Constructs an iterator at the first element of a list
+    ///
+    /// \param tag Type of elements
+    /// \param data Data starting with the first element
+    /// \param count Number of elements
+    NbtListIterator(
+        NbtTag tag,
+        std::span<unsigned char const> data,
+        std::size_t count
+    );
+
+    NbtView operator*() const;
+    NbtListIterator& operator++();
+    void operator++(int);
+    bool operator==(std::default_sentinel_t) const;
+
+private:
+    /// \brief Type of elements
+    NbtTag m_tag = NbtTag::End;
+    /// \brief Data starting with the current element
+    std::span<unsigned char const> m_data;
+    /// \brief Number of elements left
+    std::size_t m_remaining = 0;
+};
+
+/// \brief A tag of uncompressed NBT data, viewed without copying
+///
+/// Tags are decoded lazily, only when they are accessed, and skipped
+/// tags are only measured, so finding a few tags walks the data about
+/// once. Numbers are stored in big endian.
+///
+/// Methods throw std::runtime_error, if the data is malformed or the tag
+/// has a different type.
+class NbtView {
+public:
+    /// \brief Views the root tag of an NBT document
+    static NbtView root(std::span<unsigned char const> data);
+
+    /// \brief Views a payload of a given type
+    ///
+    /// \param tag Type of the payload
+    /// \param data Data starting with the payload, which may continue
+    ///             past its end
+    NbtView(NbtTag tag, std::span<unsigned char const> data);
+
+    /// \brief Type of the tag
+    NbtTag tag() const;
+
+    /// \brief Payload of the tag
+    std::span<unsigned char const> payload() const;
+
+    /// \brief Finds a child of a compound tag by name
+    ///
+    /// \return The child, or nullopt if the compound has no such child
+    std::optional<NbtView> find(std::string_view name) const;
+
+    /// \brief First element of a list tag
+    NbtListIterator begin() const;
+
+    /// \brief End of a list tag
+    std::default_sentinel_t end() const;
+
+    /// \brief Value of an integer tag of any width
+    std::int64_t as_integer() const;
+
+    /// \brief Value of a string tag, which is usually ASCII
+    std::string_view as_string() const;
+
+    /// \brief Value of a long array tag
+    std::vector<std::uint64_t> as_long_array() const;
+
+    /// \brief Value of a long array tag, written into a reused buffer
+    void as_long_array(std::vector<std::uint64_t>& values) const;
+
+private:
+    /// \brief Type of the tag
+    NbtTag m_tag;
+    /// \brief Data starting with the payload of the tag
+    std::span<unsigned char const> m_data;
+};
+
+/// \brief A section of 16x16x16 blocks of a chunk, viewed in its NBT
+///        data
+struct ChunkSection {
+    /// \brief y coordinate of the section, in sections
+    int y = 0;
+    /// \brief List of block compounds, whose names are stored in Name
+    NbtView palette;
+    /// \brief Packed block states, absent if the palette has a single
+    ///        entry
+    std::optional<NbtView> data;
+};
+
+/// \brief Finds the list of sections of a chunk
+///
+/// \param chunk Root tag of a chunk
+///
+/// \return List of section compounds, or nullopt if the chunk has none
+std::optional<NbtView> chunk_sections(NbtView chunk);
+
+/// \brief Reads a section of a chunk
+///
+/// Supports both the layout of version 1.18 and newer, and the older
+/// one.
+///
+/// \param section A section compound from chunk_sections()
+///
+/// \return The section, or nullopt if it stores no blocks
+std::optional<ChunkSection> read_section(NbtView section);
+
+/// \brief Computes the highest non-air block of a chunk
+///
+/// Reads the WORLD_SURFACE heightmap, which the game keeps for every
+/// chunk, so no section has to be decoded.
+///
+/// \param chunk Root tag of a chunk
+///
+/// \return y coordinate of the highest non-air block, lower than
+///         the bottom of the world if the chunk has no blocks, or
+///         nullopt if the chunk has no heightmap
+std::optional<int> highest_block(NbtView chunk);
+
+} // namespace core
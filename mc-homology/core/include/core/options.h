@@ -2,7 +2,11 @@
 /// \brief File containing an Options class for storing user options
 #pragma once
 
+#include <cstdint>
 #include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
 
 namespace core {
 
@@ -11,6 +15,14 @@ enum class HomologyChoice {
     Z,
     Z2,
     Z3,
+    Zp,
+};
+
+/// \brief Enum for storing user's choice of the homology algorithm
+enum class HomologyEngine {
+    Matrix,
+    Bitmap,
+    Voxel,
 };
 
 /// \brief A class for storing user options
@@ -31,6 +43,23 @@ public:
     /// \brief Type of homology to compute
     virtual HomologyChoice homology_to_compute() const = 0;
 
+    /// \brief The prime modulus of the coefficients, if Zp homology is
+    ///        computed
+    virtual std::uint64_t prime() const = 0;
+
+    /// \brief Algorithm used to compute homology
+    virtual HomologyEngine homology_engine() const = 0;
+
+    /// \brief Number of threads used to decode the save file
+    virtual unsigned threads() const = 0;
+
+    /// \brief Names of blocks treated as solid, empty for every block
+    ///        except air
+    virtual std::vector<std::string> solid_blocks() const = 0;
+
+    /// \brief Directory caching decoded chunks, if any
+    virtual std::optional<std::filesystem::path> cache_directory() const = 0;
+
     /// \brief Whether to print latex output
     virtual bool latex() const = 0;
 
@@ -63,6 +92,23 @@ public:
     /// \brief Type of homology to compute
     HomologyChoice homology_to_compute() const override;
 
+    /// \brief The prime modulus of the coefficients, if Zp homology is
+    ///        computed
+    std::uint64_t prime() const override;
+
+    /// \brief Algorithm used to compute homology
+    HomologyEngine homology_engine() const override;
+
+    /// \brief Number of threads used to decode the save file
+    unsigned threads() const override;
+
+    /// \brief Names of blocks treated as solid, empty for every block
+    ///        except air
+    std::vector<std::string> solid_blocks() const override;
+
+    /// \brief Directory caching decoded chunks, if any
+    std::optional<std::filesystem::path> cache_directory() const override;
+
     /// \brief Whether to print latex output
     bool latex() const override;
 
@@ -80,6 +126,16 @@ private:
     std::pair<int, int> m_z_bounds = {0, 0};
     /// \brief Type of homology to compute
     HomologyChoice m_homology_to_compute = HomologyChoice::Z2;
+    /// \brief The prime modulus for Zp homology
+    std::uint64_t m_prime = 0;
+    /// \brief Algorithm used to compute homology
+    HomologyEngine m_homology_engine = HomologyEngine::Matrix;
+    /// \brief Number of threads used to decode the save file
+    unsigned m_threads = 1;
+    /// \brief Names of blocks treated as solid
+    std::vector<std::string> m_solid_blocks;
+    /// \brief Directory caching decoded chunks
+    std::optional<std::filesystem::path> m_cache_directory;
     /// \brief Flag whether to print latex syntax
     bool m_latex = false;
     /// \brief Flag whether to print help
@@ -3,8 +3,12 @@
 #pragma once
 
 #include <filesystem>
+#include <optional>
 
+#include "complexes/voxel_grid.h"
+#include "core/block_filter.h"
 #include "core/complex.h"
+#include "core/options.h"
 
 namespace core {
 
@@ -38,14 +42,45 @@ public:
         MinecraftCoordinates lower_corner,
         MinecraftCoordinates upper_corner
     ) = 0;
+
+    /// \brief Reads solid blocks of a Minecraft savefile
+    ///
+    /// Reads solid blocks of a Minecraft savefile within given bounds,
+    /// without building a complex.
+    ///
+    /// \param path Path to the save file region directory
+    /// \param lower_corner Lower bounds on the studied cube
+    /// \param upper_corner Upper bounds on the studied cube
+    virtual complexes::VoxelGrid parse_voxels(
+        std::filesystem::path const& path,
+        MinecraftCoordinates lower_corner,
+        MinecraftCoordinates upper_corner
+    ) = 0;
     virtual ~MinecraftSavefileParser();
 };
 
-/// \brief A Minecraft savefile parser based on
-///        https://github.com/TCA166/mcSavefileParsers.git
+/// \brief A Minecraft savefile parser
+///
+/// Region files and chunk NBT data are read in place, without copying
+/// sections. The parser was originally based on
+/// https://github.com/TCA166/mcSavefileParsers.git, which gave it its
+/// name.
 class MinecraftSavefileParser_mcSavefileParsers:
     public MinecraftSavefileParser {
 public:
+    /// \brief Constructs a parser
+    ///
+    /// \param engine Algorithm, for which the parsed complex is built
+    /// \param threads Number of threads decoding chunks
+    /// \param filter Classification of blocks into solid and empty
+    /// \param cache_directory Directory caching decoded chunks, if any
+    explicit MinecraftSavefileParser_mcSavefileParsers(
+        HomologyEngine engine = HomologyEngine::Matrix,
+        unsigned threads = 1,
+        BlockFilter filter = {},
+        std::optional<std::filesystem::path> cache_directory = std::nullopt
+    );
+
     /// \brief Parses a Minecraft savefile
     ///
     /// Parses a Minecraft savefile within given bounds.
@@ -53,6 +88,13 @@ public:
     /// lower_corner.y <= upper_corner.y
     /// lower_corner.z <= upper_corner.z
     ///
+    /// Solid blocks are read by parse_voxels() and encoded as runs
+    /// along y. Layers without any transition between solid and empty
+    /// blocks are squeezed into one with VoxelColumns::compress_y(),
+    /// which doesn't change the homology, and the complex is built
+    /// from the squeezed runs. The bitmap engine gets a bitmap spanning
+    /// only the squeezed blocks.
+    ///
     /// \param path Path to the save file region directory
     /// \param lower_corner Lower bounds on the studied cube
     /// \param upper_corner Upper bounds on the studied cube
@@ -61,6 +103,31 @@ public:
         MinecraftCoordinates lower_corner,
         MinecraftCoordinates upper_corner
     ) override;
+
+    /// \brief Reads solid blocks of a Minecraft savefile
+    ///
+    /// Chunks are read, decompressed and decoded in a pipeline, and
+    /// their sections are merged into the grid as bitmasks. The result
+    /// doesn't depend on the number of threads.
+    ///
+    /// \param path Path to the save file region directory
+    /// \param lower_corner Lower bounds on the studied cube
+    /// \param upper_corner Upper bounds on the studied cube
+    complexes::VoxelGrid parse_voxels(
+        std::filesystem::path const& path,
+        MinecraftCoordinates lower_corner,
+        MinecraftCoordinates upper_corner
+    ) override;
+
+private:
+    /// \brief Algorithm, for which the parsed complex is built
+    HomologyEngine m_engine;
+    /// \brief Number of threads decoding chunks
+    unsigned m_threads;
+    /// \brief Classification of blocks into solid and empty
+    BlockFilter m_filter;
+    /// \brief Directory caching decoded chunks, if any
+    std::optional<std::filesystem::path> m_cache_directory;
 };
 
 } // namespace core
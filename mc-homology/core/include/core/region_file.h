@@ -0,0 +1,114 @@
+/// \file region_file.h
+/// \brief A file containing a reader of Minecraft region files
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "core/mapped_file.h"
+
+namespace core {
+
+/// \brief Compression schemes of chunks in region files
+enum class ChunkCompression : std::uint8_t {
+    Gzip = 1,
+    Zlib = 2,
+    None = 3,
+    Lz4 = 4,
+};
+
+/// \brief A compressed chunk stored in a region file
+struct CompressedChunk {
+    /// \brief Compression of the data
+    ChunkCompression compression = ChunkCompression::Zlib;
+    /// \brief Compressed NBT data of the chunk, owned by the region
+    ///        file
+    std::span<std::byte const> data;
+    /// \brief Time of the last save of the chunk, in seconds since
+    ///        the epoch
+    std::uint32_t timestamp = 0;
+};
+
+/// \brief Decompresses NBT data of a chunk
+///
+/// Throws std::runtime_error, if the compression is not supported or
+/// the data is corrupted.
+std::vector<unsigned char> decompress_chunk(CompressedChunk chunk);
+
+/// \brief A region file (.mca) mapped into memory
+///
+/// A region file stores 32x32 chunks. Its first 8 KiB contain tables
+/// of locations and timestamps of the chunks, which are parsed once
+/// when the file is opened, so absent chunks are skipped without
+/// touching the rest of the file.
+class RegionFile {
+public:
+    /// \brief Number of chunks along each horizontal axis of a region
+    constexpr static int chunks_per_side = 32;
+
+    /// \brief Opens a region file
+    ///
+    /// Throws std::runtime_error, if the file cannot be read or its
+    /// header is malformed.
+    explicit RegionFile(std::filesystem::path const& path);
+
+    /// \brief Returns compressed data of a chunk without copying it
+    ///
+    /// Throws std::out_of_range, if the coordinates are outside
+    /// of [0, 32), and std::runtime_error, if the chunk is malformed.
+    ///
+    /// \param local_x x coordinate of the chunk within the region
+    /// \param local_z z coordinate of the chunk within the region
+    ///
+    /// \return Compressed chunk, or nullopt if it has not been
+    ///         generated
+    std::optional<CompressedChunk> chunk(int local_x, int local_z) const;
+
+private:
+    /// \brief Contents of the file
+    MappedFile m_file;
+    /// \brief Locations of the chunks, as stored in the header
+    std::array<std::uint32_t, chunks_per_side * chunks_per_side>
+        m_locations = {};
+    /// \brief Timestamps of the chunks, as stored in the header
+    std::array<std::uint32_t, chunks_per_side * chunks_per_side>
+        m_timestamps = {};
+};
+
+/// \brief A region directory of a Minecraft world
+///
+/// Region files are opened lazily, the first time one of their chunks
+/// is requested, and kept open, so every file is opened at most once.
+class RegionDirectory {
+public:
+    /// \brief Constructs a reader of a region directory
+    explicit RegionDirectory(std::filesystem::path directory);
+
+    /// \brief Returns compressed data of a chunk without copying it
+    ///
+    /// The data is valid as long as the directory object.
+    ///
+    /// \param chunk_x x coordinate of the chunk in the world
+    /// \param chunk_z z coordinate of the chunk in the world
+    ///
+    /// \return Compressed chunk, or nullopt if it has not been
+    ///         generated
+    std::optional<CompressedChunk> chunk(int chunk_x, int chunk_z);
+
+private:
+    /// \brief Path to the directory
+    std::filesystem::path m_directory;
+    /// \brief Opened region files by region coordinates, null for
+    ///        missing files
+    std::map<std::pair<int, int>, std::unique_ptr<RegionFile>> m_regions;
+};
+
+} // namespace core
@@ -0,0 +1,112 @@
+/// \file voxel_cache.h
+/// \brief A file containing an on-disk cache of decoded chunks
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include "core/block_states.h"
+#include "core/mapped_file.h"
+
+namespace core {
+
+/// \brief A directory caching occupancy of decoded chunks
+///
+/// Every region has a cache file per region directory and block
+/// filter, which stores occupancy of non-empty sections of chunks as
+/// bitmasks, so reading a cached chunk is a copy out of a memory mapped
+/// file. Region directories are told apart by a hash of their canonical
+/// path, so one cache directory serves several worlds and dimensions,
+/// whose regions have the same coordinates. A cached
+/// chunk is used only if its timestamp matches the timestamp in the
+/// header of the region file, which the game updates on every save of
+/// the chunk.
+///
+/// Cache files are in the native byte order. Files written for
+/// another region directory, filter, version or byte order are ignored.
+///
+/// find() and insert() may run concurrently on two different threads,
+/// flush() may not run concurrently with anything.
+class VoxelCache {
+public:
+    /// \brief Opens a cache directory, creating it if it doesn't exist
+    ///
+    /// \param directory Path to the directory
+    /// \param region_directory Region directory, whose chunks are cached
+    /// \param fingerprint Fingerprint of the block filter, whose
+    ///        occupancy is cached
+    VoxelCache(
+        std::filesystem::path directory,
+        std::filesystem::path const& region_directory,
+        std::uint64_t fingerprint
+    );
+
+    /// \brief Looks up occupancy of a chunk
+    ///
+    /// \param chunk_x x coordinate of the chunk in the world
+    /// \param chunk_z z coordinate of the chunk in the world
+    /// \param timestamp Timestamp of the chunk in its region file
+    ///
+    /// \return Occupancy, or nullopt if it isn't cached or is stale
+    std::optional<ChunkOccupancy>
+    find(int chunk_x, int chunk_z, std::uint32_t timestamp);
+
+    /// \brief Records occupancy of a chunk, which is written by flush()
+    ///
+    /// \param chunk_x x coordinate of the chunk in the world
+    /// \param chunk_z z coordinate of the chunk in the world
+    /// \param timestamp Timestamp of the chunk in its region file
+    /// \param occupancy Occupancy of all sections of the chunk
+    void insert(
+        int chunk_x,
+        int chunk_z,
+        std::uint32_t timestamp,
+        ChunkOccupancy occupancy
+    );
+
+    /// \brief Writes cache files of regions with recorded chunks
+    ///
+    /// Files are replaced atomically, chunks cached before and not
+    /// recorded again are kept.
+    ///
+    /// Throws std::runtime_error, if a file cannot be written.
+    void flush();
+
+private:
+    /// \brief A recorded chunk
+    struct Pending {
+        /// \brief Timestamp of the chunk in its region file
+        std::uint32_t timestamp;
+        /// \brief Occupancy of the chunk
+        ChunkOccupancy occupancy;
+    };
+
+    using Region = std::pair<int, int>;
+
+    /// \brief Returns the path of the cache file of a region
+    std::filesystem::path path(Region region) const;
+
+    /// \brief Returns the mapped cache file of a region, opening it
+    ///        on the first use
+    ///
+    /// \return The file, or null if it doesn't exist or is invalid
+    MappedFile const* file(Region region);
+
+    /// \brief Path to the directory
+    std::filesystem::path m_directory;
+    /// \brief Hash of the canonical path of the region directory
+    std::uint64_t m_source;
+    /// \brief Fingerprint of the block filter
+    std::uint64_t m_fingerprint;
+    /// \brief Opened cache files by region coordinates, used by find()
+    std::map<Region, std::unique_ptr<MappedFile>> m_files;
+    /// \brief Recorded chunks by region coordinates and indices within
+    ///        the region, used by insert()
+    std::map<Region, std::map<std::size_t, Pending>> m_pending;
+};
+
+} // namespace core
@@ -0,0 +1,59 @@
+/// \file voxel_complex_3d.h
+/// \brief A file containing a concrete class VoxelComplex3D
+#pragma once
+
+#include <vector>
+
+#include "complexes/voxel_homology.h"
+#include "core/algebra_homology.h"
+#include "core/complex.h"
+
+namespace core {
+
+/// \brief A class representing a union of cubes in 3D space, whose
+///        homology is computed without matrices
+///
+/// Betti numbers are computed with `complexes::voxel_betti_numbers`.
+/// Homology of a subset of R^3 is torsion-free, so the result is exact
+/// for all coefficients.
+class VoxelComplex3D: public Complex {
+public:
+    /// \brief Adds a cube to the complex
+    void add_cube(int x, int y, int z);
+
+    /// \brief Computes Z2 homology of the complex
+    std::unique_ptr<Homology> z2_homology() const override;
+
+    /// \brief Computes Z3 homology of the complex
+    std::unique_ptr<Homology> z3_homology() const override;
+
+    /// \brief Computes Zp homology of the complex
+    std::unique_ptr<Homology> zp_homology(std::uint64_t p) const override;
+
+    /// \brief Computes Z homology of the complex
+    std::unique_ptr<Homology> z_homology() const override;
+
+    /// \brief Computes homology of the complex for coefficients
+    ///        of type T
+    template<class T>
+    std::unique_ptr<AlgebraHomology<T>> homology() const {
+        auto betti_numbers = complexes::voxel_betti_numbers(m_voxels);
+        std::vector<std::vector<T>> torsion(betti_numbers.size());
+        return std::make_unique<AlgebraHomology<T>>(algebra::Homology<T> {
+            .betti_numbers = std::move(betti_numbers),
+            .torsion = std::move(torsion)
+        });
+    }
+
+    /// \brief Decreases the complex's size without changing its
+    ///        homology
+    ///
+    /// Removes repeated cubes.
+    void reduce() override;
+
+private:
+    /// \brief Cubes of the complex
+    std::vector<complexes::Voxel> m_voxels;
+};
+
+} // namespace core
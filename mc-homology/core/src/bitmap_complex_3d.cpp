@@ -0,0 +1,40 @@
+#include "../include/core/bitmap_complex_3d.h"
+
+#include "algebra/dynamic_modulo_field.h"
+#include "algebra/integer.h"
+#include "algebra/z2_field.h"
+
+namespace core {
+
+BitmapComplex3D::BitmapComplex3D(
+    complexes::Voxel lower,
+    complexes::Voxel upper
+) :
+    m_inner(lower, upper) {}
+
+void BitmapComplex3D::add_cube(int x, int y, int z) {
+    m_inner.add_cube({.x = x, .y = y, .z = z});
+}
+
+std::unique_ptr<Homology> BitmapComplex3D::z2_homology() const {
+    return homology<algebra::Z2>();
+}
+
+std::unique_ptr<Homology> BitmapComplex3D::z3_homology() const {
+    return homology<algebra::ZModP<3>>();
+}
+
+std::unique_ptr<Homology> BitmapComplex3D::zp_homology(std::uint64_t p) const {
+    algebra::DynamicZModP::Modulus const modulus(p);
+    return homology<algebra::DynamicZModP>();
+}
+
+std::unique_ptr<Homology> BitmapComplex3D::z_homology() const {
+    return homology<algebra::Integer>();
+}
+
+void BitmapComplex3D::reduce() {
+    m_inner.collapse();
+}
+
+} // namespace core
@@ -0,0 +1,66 @@
+#include "../include/core/block_filter.h"
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <utility>
+
+namespace {
+
+constexpr std::string_view default_namespace = "minecraft:";
+
+/// \brief Names of blocks, which the game considers air
+constexpr std::array<std::string_view, 3> air_blocks = {
+    "minecraft:air",
+    "minecraft:cave_air",
+    "minecraft:void_air",
+};
+
+} // namespace
+
+namespace core {
+
+BlockFilter::BlockFilter() = default;
+
+BlockFilter::BlockFilter(std::vector<std::string> solid_blocks) :
+    m_solid_blocks(std::move(solid_blocks)) {
+    for (auto& block : m_solid_blocks) {
+        if (!block.contains(':')) {
+            block.insert(0, default_namespace);
+        }
+    }
+    std::ranges::sort(m_solid_blocks);
+    // stone and minecraft:stone are the same block
+    auto const duplicates = std::ranges::unique(m_solid_blocks);
+    m_solid_blocks.erase(duplicates.begin(), duplicates.end());
+}
+
+bool BlockFilter::is_solid(std::string_view block) const {
+    if (m_solid_blocks.empty()) {
+        return std::ranges::find(air_blocks, block) == air_blocks.end();
+    }
+    return std::ranges::binary_search(m_solid_blocks, block, std::less<> {});
+}
+
+bool BlockFilter::has_solid_air() const {
+    return std::ranges::any_of(air_blocks, [this](std::string_view block) {
+        return is_solid(block);
+    });
+}
+
+std::uint64_t BlockFilter::fingerprint() const {
+    // 64-bit FNV-1a of the names, each followed by a separator
+    std::uint64_t hash = 0xcbf29ce484222325;
+    auto const add = [&hash](unsigned char byte) {
+        hash = (hash ^ byte) * 0x100000001b3;
+    };
+    for (auto const& block : m_solid_blocks) {
+        for (auto c : block) {
+            add(static_cast<unsigned char>(c));
+        }
+        add('\n');
+    }
+    return hash;
+}
+
+} // namespace core
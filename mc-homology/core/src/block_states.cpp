@@ -0,0 +1,288 @@
+#include "../include/core/block_states.h"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define MC_HOMOLOGY_HAS_AVX2 1
+#else
+#define MC_HOMOLOGY_HAS_AVX2 0
+#endif
+
+namespace {
+
+using core::blocks_per_section;
+using core::SectionOccupancy;
+
+/// \brief Layout of packed block states
+struct Packing {
+    /// \brief Number of bits of a block state
+    unsigned bits;
+    /// \brief Number of block states in a 64-bit integer
+    std::size_t per_word;
+    /// \brief Mask of the bits of a block state
+    std::uint64_t mask;
+};
+
+/// \brief Computes the layout and checks that the data is long enough
+Packing checked_packing(
+    std::span<std::uint64_t const> data,
+    std::size_t palette_size
+) {
+    auto const bits = core::bits_per_block(palette_size);
+    Packing const result = {
+        .bits = bits,
+        .per_word = 64 / bits,
+        .mask = (std::uint64_t {1} << bits) - 1,
+    };
+    auto const words =
+        (blocks_per_section + result.per_word - 1) / result.per_word;
+    if (data.size() < words) [[unlikely]] {
+        throw std::runtime_error("Malformed block states of a section");
+    }
+    return result;
+}
+
+/// \brief Sets bits of the occupancy of blocks starting at a given one
+void set_occupancy(
+    SectionOccupancy& occupancy,
+    std::size_t block,
+    std::uint64_t bits
+) {
+    occupancy[block / 64] |= bits << (block % 64);
+    if (block % 64 != 0 && block / 64 + 1 < occupancy.size()) {
+        occupancy[block / 64 + 1] |= bits >> (64 - block % 64);
+    }
+}
+
+/// \brief Unpacks block states starting from a given word one at a time
+void unpack_scalar(
+    std::span<std::uint64_t const> data,
+    Packing packing,
+    std::span<std::uint16_t, blocks_per_section> indices,
+    std::size_t word,
+    std::size_t block
+) {
+    for (; block < blocks_per_section; ++word) {
+        auto value = data[word];
+        for (std::size_t i = 0; i < packing.per_word
+             && block < blocks_per_section;
+             ++i, ++block) {
+            indices[block] = static_cast<std::uint16_t>(value & packing.mask);
+            value >>= packing.bits;
+        }
+    }
+}
+
+/// \brief Returns occupancy of a section with at most one palette entry
+SectionOccupancy single_entry_occupancy(std::vector<bool> const& solid) {
+    SectionOccupancy occupancy = {};
+    if (!solid.empty() && solid[0]) {
+        std::ranges::fill(occupancy, ~std::uint64_t {0});
+    }
+    return occupancy;
+}
+
+/// \brief Looks up occupancy of unpacked palette indices
+SectionOccupancy index_occupancy(
+    std::span<std::uint16_t const, blocks_per_section> indices,
+    std::vector<bool> const& solid
+) {
+    SectionOccupancy occupancy = {};
+    for (std::size_t block = 0; block < blocks_per_section; ++block) {
+        if (indices[block] < solid.size() && solid[indices[block]]) {
+            occupancy[block / 64] |= std::uint64_t {1} << (block % 64);
+        }
+    }
+    return occupancy;
+}
+
+#if MC_HOMOLOGY_HAS_AVX2
+
+bool has_avx2() {
+    static bool const supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+
+/// \brief Vector shifts extracting groups of 4 block states of a word
+///
+/// Lanes past the last block state of a word are shifted out entirely,
+/// so they are 0.
+struct Shifts {
+    __m256i groups[4];
+    std::size_t count;
+};
+
+[[gnu::target("avx2")]] Shifts group_shifts(Packing packing) {
+    Shifts result {};
+    result.count = (packing.per_word + 3) / 4;
+    for (std::size_t group = 0; group < result.count; ++group) {
+        auto const first = static_cast<long long>(4 * group * packing.bits);
+        auto const bits = static_cast<long long>(packing.bits);
+        result.groups[group] = _mm256_setr_epi64x(
+            first,
+            first + bits,
+            first + 2 * bits,
+            first + 3 * bits
+        );
+    }
+    return result;
+}
+
+/// \brief Unpacks every word into 4 block states per vector
+///
+/// Groups of 4 block states are stored whole, so stores past the end
+/// of a word are overwritten by the next word. The last words, whose
+/// stores would go past the end of the section, are unpacked by
+/// unpack_scalar().
+[[gnu::target("avx2")]] void unpack_avx2(
+    std::span<std::uint64_t const> data,
+    Packing packing,
+    std::span<std::uint16_t, blocks_per_section> indices
+) {
+    auto const shifts = group_shifts(packing);
+    auto const mask = _mm256_set1_epi64x(static_cast<long long>(packing.mask));
+    // moves the low halves of 64-bit lanes into the low 128 bits
+    auto const low_halves = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+    std::size_t word = 0;
+    std::size_t block = 0;
+    for (; block + 4 * shifts.count <= blocks_per_section; ++word) {
+        auto const value =
+            _mm256_set1_epi64x(static_cast<long long>(data[word]));
+        for (std::size_t group = 0; group < shifts.count; ++group) {
+            auto const states = _mm256_and_si256(
+                _mm256_srlv_epi64(value, shifts.groups[group]),
+                mask
+            );
+            auto const halves = _mm256_castsi256_si128(
+                _mm256_permutevar8x32_epi32(states, low_halves)
+            );
+            _mm_storel_epi64(
+                reinterpret_cast<__m128i*>(&indices[block + 4 * group]),
+                _mm_packus_epi32(halves, halves)
+            );
+        }
+        block += packing.per_word;
+    }
+    unpack_scalar(data, packing, indices, word, block);
+}
+
+/// \brief Unpacks every word into occupancy of 4 blocks per vector
+///
+/// The palette has to have at most 64 entries, whose flags are looked
+/// up by shifting a single 64-bit mask.
+[[gnu::target("avx2")]] SectionOccupancy occupancy_avx2(
+    std::span<std::uint64_t const> data,
+    Packing packing,
+    std::uint64_t solid_mask
+) {
+    SectionOccupancy occupancy = {};
+    auto const shifts = group_shifts(packing);
+    auto const mask = _mm256_set1_epi64x(static_cast<long long>(packing.mask));
+    auto const solid = _mm256_set1_epi64x(static_cast<long long>(solid_mask));
+    std::size_t block = 0;
+    for (std::size_t word = 0; block < blocks_per_section; ++word) {
+        auto const value =
+            _mm256_set1_epi64x(static_cast<long long>(data[word]));
+        auto const count =
+            std::min(packing.per_word, blocks_per_section - block);
+        for (std::size_t group = 0; 4 * group < count; ++group) {
+            auto const states = _mm256_and_si256(
+                _mm256_srlv_epi64(value, shifts.groups[group]),
+                mask
+            );
+            // shifts by 64 or more give 0, so indices outside of
+            // the palette are empty
+            auto const flags =
+                _mm256_slli_epi64(_mm256_srlv_epi64(solid, states), 63);
+            auto bits = static_cast<std::uint64_t>(
+                _mm256_movemask_pd(_mm256_castsi256_pd(flags))
+            );
+            auto const lanes = std::min<std::size_t>(4, count - 4 * group);
+            bits &= (std::uint64_t {1} << lanes) - 1;
+            set_occupancy(occupancy, block + 4 * group, bits);
+        }
+        block += count;
+    }
+    return occupancy;
+}
+
+#endif
+
+} // namespace
+
+namespace core {
+
+unsigned bits_per_block(std::size_t palette_size) {
+    // the game never packs block states into less than 4 bits
+    auto const bits = static_cast<unsigned>(std::bit_width(palette_size - 1));
+    return std::max(4u, bits);
+}
+
+void unpack_block_states(
+    std::span<std::uint64_t const> data,
+    std::size_t palette_size,
+    std::span<std::uint16_t, blocks_per_section> indices
+) {
+#if MC_HOMOLOGY_HAS_AVX2
+    if (palette_size > 1 && has_avx2()) {
+        unpack_avx2(data, checked_packing(data, palette_size), indices);
+        return;
+    }
+#endif
+    detail::unpack_block_states_scalar(data, palette_size, indices);
+}
+
+SectionOccupancy unpack_occupancy(
+    std::span<std::uint64_t const> data,
+    std::vector<bool> const& solid
+) {
+    if (solid.size() <= 1) {
+        return single_entry_occupancy(solid);
+    }
+#if MC_HOMOLOGY_HAS_AVX2
+    if (has_avx2() && solid.size() <= 64) {
+        std::uint64_t solid_mask = 0;
+        for (std::size_t i = 0; i < solid.size(); ++i) {
+            solid_mask |= std::uint64_t {solid[i]} << i;
+        }
+        auto const packing = checked_packing(data, solid.size());
+        return occupancy_avx2(data, packing, solid_mask);
+    }
+#endif
+    std::array<std::uint16_t, blocks_per_section> indices;
+    unpack_block_states(data, solid.size(), indices);
+    return index_occupancy(indices, solid);
+}
+
+namespace detail {
+
+void unpack_block_states_scalar(
+    std::span<std::uint64_t const> data,
+    std::size_t palette_size,
+    std::span<std::uint16_t, blocks_per_section> indices
+) {
+    if (palette_size <= 1) {
+        std::ranges::fill(indices, 0);
+        return;
+    }
+    unpack_scalar(data, checked_packing(data, palette_size), indices, 0, 0);
+}
+
+SectionOccupancy unpack_occupancy_scalar(
+    std::span<std::uint64_t const> data,
+    std::vector<bool> const& solid
+) {
+    if (solid.size() <= 1) {
+        return single_entry_occupancy(solid);
+    }
+    std::array<std::uint16_t, blocks_per_section> indices;
+    unpack_block_states_scalar(data, solid.size(), indices);
+    return index_occupancy(indices, solid);
+}
+
+} // namespace detail
+
+} // namespace core
@@ -1,5 +1,6 @@
 #include "../include/core/cubical_complex_3d.h"
 
+#include "algebra/dynamic_modulo_field.h"
 #include "algebra/integer.h"
 #include "algebra/z2_field.h"
 #include "complexes/cubical_complex.h"
@@ -24,12 +25,17 @@ std::unique_ptr<Homology> CubicalComplex3D::z3_homology() const {
     return homology<algebra::ZModP<3>>();
 }
 
+std::unique_ptr<Homology> CubicalComplex3D::zp_homology(std::uint64_t p) const {
+    algebra::DynamicZModP::Modulus const modulus(p);
+    return homology<algebra::DynamicZModP>();
+}
+
 std::unique_ptr<Homology> CubicalComplex3D::z_homology() const {
     return homology<algebra::Integer>();
 }
 
 void CubicalComplex3D::reduce() {
-    throw std::logic_error("Not implemented yet");
+    m_inner.collapse();
 }
 
 } // namespace core
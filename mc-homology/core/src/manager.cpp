@@ -1,9 +1,11 @@
 #include "../include/core/manager.h"
 
+#include <format>
 #include <print>
 #include <stdexcept>
 #include <utility>
 
+#include "core/block_filter.h"
 #include "core/homology_printing_strategy.h"
 #include "core/latex_wrapper.h"
 #include "core/options.h"
@@ -44,14 +46,28 @@ int Manager::run() {
     if (m_options->help()) {
         std::println("Usage:");
         std::println(
-            "mc-homology [-h | --help] [--Z | --Z2 | --Z3] [--latex | --no-latex] \\\n"
-            "  [--x <x1> <x2>] [--y <y1> <y2>] [--z <z1> <z2>] <path-to-region-directory>"
+            "mc-homology [-h | --help] [--Z | --Z2 | --Z3 | --Zp <p>] \\\n"
+            "  [--matrix | --bitmap | --voxel] \\\n"
+            "  [--latex | --no-latex] [--x <x1> <x2>] [--y <y1> <y2>] [--z <z1> <z2>] \\\n"
+            "  [--threads <n>] [--blocks <b1,b2,...>] [--cache <dir>] \\\n"
+            "  <path-to-region-directory>"
         );
         std::println("Options:");
         std::println("-h | --help");
         std::println("  Print help and exit.");
-        std::println("--Z | --Z2 | --Z3");
+        std::println("--Z | --Z2 | --Z3 | --Zp <p>");
         std::println("  Choose coefficients of the chain complex");
+        std::println("  Zp uses integers mod a prime p below 2^63.");
+        std::println("--matrix | --bitmap | --voxel");
+        std::println(
+            "  Choose the algorithm: reduction of boundary matrices (default),"
+        );
+        std::println(
+            "  reduction of boundary matrices of a bitmap over the bounds"
+        );
+        std::println(
+            "  or a matrix-free algorithm based on the Euler characteristic"
+        );
         std::println("--latex | --no-latex");
         std::println("  Choose, whether to print the output in .tex syntax");
         std::println("--x <x1> <x2>");
@@ -60,11 +76,30 @@ int Manager::run() {
         std::println("  Choose y bounds of the save file. y1 <= y < y2");
         std::println("--z <z1> <z2>");
         std::println("  Choose z bounds of the save file. z1 <= z < z2");
+        std::println("--threads <n>");
+        std::println(
+            "  Choose the number of threads decoding the save file."
+        );
+        std::println("  Defaults to the number of hardware threads.");
+        std::println("--blocks <b1,b2,...>");
+        std::println(
+            "  Choose blocks treated as solid, e.g. stone,minecraft:dirt."
+        );
+        std::println("  Defaults to every block except air.");
+        std::println("--cache <dir>");
+        std::println(
+            "  Cache decoded chunks in a directory and reuse them in later runs."
+        );
         std::println("<path-to-region-directory");
         std::println("Path to the region directory of a minecraft save.");
         return 0;
     }
-    auto parser = std::make_unique<MinecraftSavefileParser_mcSavefileParsers>();
+    auto parser = std::make_unique<MinecraftSavefileParser_mcSavefileParsers>(
+        m_options->homology_engine(),
+        m_options->threads(),
+        BlockFilter(m_options->solid_blocks()),
+        m_options->cache_directory()
+    );
     MinecraftCoordinates lower_corner = {
         .x = m_options->x_bounds().first,
         .y = m_options->y_bounds().first,
@@ -77,6 +112,7 @@ int Manager::run() {
     };
     auto complex =
         parser->parse(m_options->filename(), lower_corner, upper_corner);
+    complex->reduce();
     std::unique_ptr<Homology> homology;
     switch (m_options->homology_to_compute()) {
         case HomologyChoice::Z: {
@@ -91,6 +127,10 @@ int Manager::run() {
             homology = complex->z3_homology();
             break;
         }
+        case HomologyChoice::Zp: {
+            homology = complex->zp_homology(m_options->prime());
+            break;
+        }
     }
     std::unique_ptr<HomologyPrintingStrategy> printing_strategy;
     if (m_options->latex()) {
@@ -110,6 +150,12 @@ int Manager::run() {
                     std::make_unique<HomologyLatexPrint>("\\mathbb{Z}_{3}");
                 break;
             }
+            case HomologyChoice::Zp: {
+                printing_strategy = std::make_unique<HomologyLatexPrint>(
+                    std::format("\\mathbb{{Z}}_{{{}}}", m_options->prime())
+                );
+                break;
+            }
         }
     } else {
         printing_strategy = std::make_unique<HomologyRawPrint>();
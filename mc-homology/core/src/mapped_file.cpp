@@ -0,0 +1,80 @@
+#include "../include/core/mapped_file.h"
+
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MC_HOMOLOGY_HAS_MMAP 1
+#else
+#define MC_HOMOLOGY_HAS_MMAP 0
+#endif
+
+namespace core {
+
+MappedFile::MappedFile(std::filesystem::path const& path) {
+#if MC_HOMOLOGY_HAS_MMAP
+    int const fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error(
+            std::format("Cannot open file {}", path.string())
+        );
+    }
+    struct stat status {};
+    if (::fstat(fd, &status) != 0) {
+        ::close(fd);
+        throw std::runtime_error(
+            std::format("Cannot read file {}", path.string())
+        );
+    }
+    auto const size = static_cast<std::size_t>(status.st_size);
+    if (size != 0) {
+        void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            ::close(fd);
+            throw std::runtime_error(
+                std::format("Cannot map file {}", path.string())
+            );
+        }
+        m_mapping = mapping;
+        m_data = {static_cast<std::byte const*>(mapping), size};
+    }
+    ::close(fd);
+#else
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error(
+            std::format("Cannot open file {}", path.string())
+        );
+    }
+    std::vector<char> contents(
+        (std::istreambuf_iterator<char>(file)),
+        std::istreambuf_iterator<char>()
+    );
+    m_buffer.resize(contents.size());
+    std::ranges::transform(contents, m_buffer.begin(), [](char c) {
+        return static_cast<std::byte>(c);
+    });
+    m_data = m_buffer;
+#endif
+}
+
+MappedFile::~MappedFile() {
+#if MC_HOMOLOGY_HAS_MMAP
+    if (m_mapping) {
+        ::munmap(m_mapping, m_data.size());
+    }
+#endif
+}
+
+std::span<std::byte const> MappedFile::data() const {
+    return m_data;
+}
+
+} // namespace core
@@ -0,0 +1,337 @@
+#include "../include/core/nbt.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+using core::NbtTag;
+
+/// \brief Number of columns of blocks in a chunk
+constexpr std::size_t chunk_columns = 16 * 16;
+
+void require(std::span<unsigned char const> data, std::size_t size) {
+    if (data.size() < size) [[unlikely]] {
+        throw std::runtime_error("Malformed NBT data");
+    }
+}
+
+/// \brief Reads an unsigned big endian integer of a given width
+std::uint64_t read_big_endian(
+    std::span<unsigned char const> data,
+    std::size_t width
+) {
+    require(data, width);
+    std::uint64_t result = 0;
+    for (std::size_t i = 0; i < width; ++i) {
+        result = (result << 8) | data[i];
+    }
+    return result;
+}
+
+/// \brief Reads a length of an array or a list
+std::size_t read_length(std::span<unsigned char const> data) {
+    auto const length =
+        static_cast<std::int32_t>(read_big_endian(data, 4));
+    if (length < 0) [[unlikely]] {
+        throw std::runtime_error("Malformed NBT data");
+    }
+    return static_cast<std::size_t>(length);
+}
+
+/// \brief Returns size of a fixed size payload, or 0 for other tags
+std::size_t fixed_size(NbtTag tag) {
+    switch (tag) {
+        case NbtTag::Byte: {
+            return 1;
+        }
+        case NbtTag::Short: {
+            return 2;
+        }
+        case NbtTag::Int:
+        case NbtTag::Float: {
+            return 4;
+        }
+        case NbtTag::Long:
+        case NbtTag::Double: {
+            return 8;
+        }
+        default: {
+            return 0;
+        }
+    }
+}
+
+/// \brief Computes size of a payload, which starts the data
+std::size_t payload_size(NbtTag tag, std::span<unsigned char const> data) {
+    std::size_t size = 0;
+    switch (tag) {
+        case NbtTag::End: {
+            break;
+        }
+        case NbtTag::Byte:
+        case NbtTag::Short:
+        case NbtTag::Int:
+        case NbtTag::Long:
+        case NbtTag::Float:
+        case NbtTag::Double: {
+            size = fixed_size(tag);
+            break;
+        }
+        case NbtTag::ByteArray: {
+            size = 4 + read_length(data);
+            break;
+        }
+        case NbtTag::IntArray: {
+            size = 4 + 4 * read_length(data);
+            break;
+        }
+        case NbtTag::LongArray: {
+            size = 4 + 8 * read_length(data);
+            break;
+        }
+        case NbtTag::String: {
+            size = 2 + read_big_endian(data, 2);
+            break;
+        }
+        case NbtTag::List: {
+            require(data, 5);
+            auto const element = static_cast<NbtTag>(data[0]);
+            auto const length = read_length(data.subspan(1));
+            size = 5;
+            if (fixed_size(element) != 0) {
+                size += length * fixed_size(element);
+                break;
+            }
+            for (std::size_t i = 0; i < length; ++i) {
+                size += payload_size(element, data.subspan(size));
+            }
+            break;
+        }
+        case NbtTag::Compound: {
+            while (true) {
+                require(data, size + 1);
+                auto const child = static_cast<NbtTag>(data[size]);
+                size += 1;
+                if (child == NbtTag::End) {
+                    break;
+                }
+                size += 2 + read_big_endian(data.subspan(size), 2);
+                require(data, size);
+                size += payload_size(child, data.subspan(size));
+            }
+            break;
+        }
+        default: {
+            throw std::runtime_error("Malformed NBT data");
+        }
+    }
+    require(data, size);
+    return size;
+}
+
+} // namespace
+
+namespace core {
+
+NbtListIterator::NbtListIterator(
+    NbtTag tag,
+    std::span<unsigned char const> data,
+    std::size_t count
+) :
+    m_tag(tag),
+    m_data(data),
+    m_remaining(count) {}
+
+NbtView NbtListIterator::operator*() const {
+    return NbtView(m_tag, m_data);
+}
+
+NbtListIterator& NbtListIterator::operator++() {
+    m_data = m_data.subspan(payload_size(m_tag, m_data));
+    --m_remaining;
+    return *this;
+}
+
+void NbtListIterator::operator++(int) {
+    ++*this;
+}
+
+bool NbtListIterator::operator==(std::default_sentinel_t) const {
+    return m_remaining == 0;
+}
+
+NbtView NbtView::root(std::span<unsigned char const> data) {
+    require(data, 3);
+    auto const tag = static_cast<NbtTag>(data[0]);
+    auto const name_length = read_big_endian(data.subspan(1), 2);
+    require(data, 3 + name_length);
+    return NbtView(tag, data.subspan(3 + name_length));
+}
+
+NbtView::NbtView(NbtTag tag, std::span<unsigned char const> data) :
+    m_tag(tag),
+    m_data(data) {}
+
+NbtTag NbtView::tag() const {
+    return m_tag;
+}
+
+std::span<unsigned char const> NbtView::payload() const {
+    return m_data.first(payload_size(m_tag, m_data));
+}
+
+std::optional<NbtView> NbtView::find(std::string_view name) const {
+    if (m_tag != NbtTag::Compound) [[unlikely]] {
+        throw std::runtime_error("Expected an NBT compound");
+    }
+    auto data = m_data;
+    while (true) {
+        require(data, 1);
+        auto const child = static_cast<NbtTag>(data[0]);
+        if (child == NbtTag::End) {
+            return std::nullopt;
+        }
+        auto const name_length = read_big_endian(data.subspan(1), 2);
+        require(data, 3 + name_length);
+        auto const child_name = std::string_view(
+            reinterpret_cast<char const*>(data.data() + 3),
+            name_length
+        );
+        data = data.subspan(3 + name_length);
+        if (child_name == name) {
+            return NbtView(child, data);
+        }
+        data = data.subspan(payload_size(child, data));
+    }
+}
+
+NbtListIterator NbtView::begin() const {
+    if (m_tag != NbtTag::List) [[unlikely]] {
+        throw std::runtime_error("Expected an NBT list");
+    }
+    require(m_data, 5);
+    return NbtListIterator(
+        static_cast<NbtTag>(m_data[0]),
+        m_data.subspan(5),
+        read_length(m_data.subspan(1))
+    );
+}
+
+std::default_sentinel_t NbtView::end() const {
+    return std::default_sentinel;
+}
+
+std::int64_t NbtView::as_integer() const {
+    auto const width = fixed_size(m_tag);
+    if (m_tag == NbtTag::Float || m_tag == NbtTag::Double || width == 0)
+        [[unlikely]] {
+        throw std::runtime_error("Expected an NBT integer");
+    }
+    auto const value = read_big_endian(m_data, width);
+    // sign extension of the most significant byte
+    auto const shift = 64 - 8 * width;
+    return static_cast<std::int64_t>(value << shift) >> shift;
+}
+
+std::string_view NbtView::as_string() const {
+    if (m_tag != NbtTag::String) [[unlikely]] {
+        throw std::runtime_error("Expected an NBT string");
+    }
+    auto const length = read_big_endian(m_data, 2);
+    require(m_data, 2 + length);
+    return {reinterpret_cast<char const*>(m_data.data() + 2), length};
+}
+
+std::vector<std::uint64_t> NbtView::as_long_array() const {
+    std::vector<std::uint64_t> values;
+    as_long_array(values);
+    return values;
+}
+
+void NbtView::as_long_array(std::vector<std::uint64_t>& values) const {
+    if (m_tag != NbtTag::LongArray) [[unlikely]] {
+        throw std::runtime_error("Expected an NBT long array");
+    }
+    auto const length = read_length(m_data);
+    require(m_data, 4 + 8 * length);
+    values.resize(length);
+    for (std::size_t i = 0; i < length; ++i) {
+        values[i] = read_big_endian(m_data.subspan(4 + 8 * i), 8);
+    }
+}
+
+std::optional<NbtView> chunk_sections(NbtView chunk) {
+    auto const level = chunk.find("Level");
+    if (level) {
+        return level->find("Sections");
+    }
+    return chunk.find("sections");
+}
+
+std::optional<ChunkSection> read_section(NbtView section) {
+    auto const y = section.find("Y");
+    if (!y) {
+        return std::nullopt;
+    }
+    // since version 1.18 the palette and the data are in a separate
+    // compound
+    std::optional<NbtView> palette;
+    std::optional<NbtView> data;
+    if (auto const block_states = section.find("block_states")) {
+        palette = block_states->find("palette");
+        data = block_states->find("data");
+    } else {
+        palette = section.find("Palette");
+        data = section.find("BlockStates");
+    }
+    if (!palette) {
+        return std::nullopt;
+    }
+    return ChunkSection {
+        .y = static_cast<int>(y->as_integer()),
+        .palette = *palette,
+        .data = data,
+    };
+}
+
+std::optional<int> highest_block(NbtView chunk) {
+    // chunks before version 1.18 store everything in a Level compound
+    auto const level = chunk.find("Level");
+    auto const& compound = level ? *level : chunk;
+    auto const heightmaps = compound.find("Heightmaps");
+    if (!heightmaps) {
+        return std::nullopt;
+    }
+    auto const surface = heightmaps->find("WORLD_SURFACE");
+    if (!surface) {
+        return std::nullopt;
+    }
+    auto const heights = surface->as_long_array();
+    // heights are packed into as few bits as the height of the world
+    // needs, which is the smallest width filling the array
+    std::size_t bits = 1;
+    while (bits <= 32
+           && (chunk_columns + 64 / bits - 1) / (64 / bits) != heights.size()) {
+        ++bits;
+    }
+    if (bits > 32) {
+        return std::nullopt;
+    }
+    auto const per_word = 64 / bits;
+    auto const mask = (std::uint64_t {1} << bits) - 1;
+    std::uint64_t height = 0;
+    for (std::size_t column = 0; column < chunk_columns; ++column) {
+        auto const word = heights[column / per_word];
+        height = std::max(height, (word >> (column % per_word * bits)) & mask);
+    }
+    // heights are counted from the bottom of the world, which is
+    // stored since version 1.18 as the lowest section
+    auto const lowest_section = compound.find("yPos");
+    auto const bottom =
+        lowest_section ? 16 * static_cast<int>(lowest_section->as_integer())
+                       : 0;
+    return bottom + static_cast<int>(height) - 1;
+}
+
+} // namespace core
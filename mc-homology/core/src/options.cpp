@@ -1,7 +1,15 @@
 #include "../include/core/options.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <cstring>
+#include <ranges>
 #include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "algebra/number_theory.h"
 
 namespace core {
 
@@ -11,6 +19,7 @@ CommandlineOptions::CommandlineOptions(int argc, char** argv) {
     if (argc < 2) {
         throw std::invalid_argument("At least 2 arguments required");
     }
+    m_threads = std::max(1u, std::thread::hardware_concurrency());
     for (int i = 1; i < argc; ++i) {
         if (std::strcmp(argv[i], "-h") == 0
             || std::strcmp(argv[i], "--help") == 0) {
@@ -31,6 +40,31 @@ CommandlineOptions::CommandlineOptions(int argc, char** argv) {
             m_homology_to_compute = HomologyChoice::Z3;
         } else if (std::strcmp(argv[i], "--Z") == 0) {
             m_homology_to_compute = HomologyChoice::Z;
+        } else if (std::strcmp(argv[i], "--Zp") == 0) {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("Not enough arguments for --Zp");
+            }
+            std::uint64_t prime = 0;
+            try {
+                prime = std::stoull(argv[i + 1]);
+            } catch (std::logic_error&) {
+                throw std::invalid_argument("Expected a prime number");
+            }
+            if (prime >= std::uint64_t {1} << 63
+                || !algebra::is_prime_u64(prime)) {
+                throw std::invalid_argument("Expected a prime below 2^63");
+            }
+            // Z2 has a dedicated, faster implementation
+            m_homology_to_compute =
+                prime == 2 ? HomologyChoice::Z2 : HomologyChoice::Zp;
+            m_prime = prime;
+            i += 1;
+        } else if (std::strcmp(argv[i], "--matrix") == 0) {
+            m_homology_engine = HomologyEngine::Matrix;
+        } else if (std::strcmp(argv[i], "--bitmap") == 0) {
+            m_homology_engine = HomologyEngine::Bitmap;
+        } else if (std::strcmp(argv[i], "--voxel") == 0) {
+            m_homology_engine = HomologyEngine::Voxel;
         } else if (std::strcmp(argv[i], "--latex") == 0) {
             m_latex = true;
         } else if (std::strcmp(argv[i], "--no-latex") == 0) {
@@ -65,6 +99,46 @@ CommandlineOptions::CommandlineOptions(int argc, char** argv) {
                 throw std::invalid_argument("Expected numbers for bounds");
             }
             i += 2;
+        } else if (std::strcmp(argv[i], "--threads") == 0) {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument(
+                    "Not enough arguments for --threads"
+                );
+            }
+            int threads = 0;
+            try {
+                threads = std::stoi(argv[i + 1]);
+            } catch (std::invalid_argument&) {
+                throw std::invalid_argument("Expected a number of threads");
+            }
+            if (threads < 1) {
+                throw std::invalid_argument("Expected a positive number");
+            }
+            m_threads = static_cast<unsigned>(threads);
+            i += 1;
+        } else if (std::strcmp(argv[i], "--blocks") == 0) {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument(
+                    "Not enough arguments for --blocks"
+                );
+            }
+            m_solid_blocks.clear();
+            for (auto const block :
+                 std::string_view(argv[i + 1]) | std::views::split(',')) {
+                if (block.empty()) {
+                    throw std::invalid_argument("Expected a block name");
+                }
+                m_solid_blocks.emplace_back(block.begin(), block.end());
+            }
+            i += 1;
+        } else if (std::strcmp(argv[i], "--cache") == 0) {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument(
+                    "Not enough arguments for --cache"
+                );
+            }
+            m_cache_directory = argv[i + 1];
+            i += 1;
         }
     }
     if (m_filename.empty()) {
@@ -92,6 +166,27 @@ HomologyChoice CommandlineOptions::homology_to_compute() const {
     return m_homology_to_compute;
 }
 
+std::uint64_t CommandlineOptions::prime() const {
+    return m_prime;
+}
+
+HomologyEngine CommandlineOptions::homology_engine() const {
+    return m_homology_engine;
+}
+
+unsigned CommandlineOptions::threads() const {
+    return m_threads;
+}
+
+std::vector<std::string> CommandlineOptions::solid_blocks() const {
+    return m_solid_blocks;
+}
+
+std::optional<std::filesystem::path>
+CommandlineOptions::cache_directory() const {
+    return m_cache_directory;
+}
+
 bool CommandlineOptions::latex() const {
     return m_latex;
 }
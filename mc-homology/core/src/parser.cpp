@@ -1,13 +1,28 @@
 #include "../include/core/parser.h"
 
-#include <cstring>
-
-extern "C" {
-#include <chunkParser.h>
-#include <regionParser.h>
-}
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
 
+#include "complexes/voxel_columns.h"
+#include "complexes/voxel_homology.h"
+#include "core/bitmap_complex_3d.h"
+#include "core/block_states.h"
+#include "core/bounded_queue.h"
 #include "core/cubical_complex_3d.h"
+#include "core/nbt.h"
+#include "core/region_file.h"
+#include "core/voxel_cache.h"
+#include "core/voxel_complex_3d.h"
 
 namespace {
 
@@ -23,70 +38,427 @@ std::pair<int, int> get_upper_chunk_coords(int block_x, int block_z) {
 
 namespace core {
 
-MinecraftSavefileParser::~MinecraftSavefileParser() = default;
+namespace {
 
-std::unique_ptr<Complex> MinecraftSavefileParser_mcSavefileParsers::parse(
-    std::filesystem::path const& path,
+/// \brief A generated chunk, which has to be decompressed
+struct ChunkJob {
+    /// \brief x coordinate of the chunk
+    int chunk_x = 0;
+    /// \brief z coordinate of the chunk
+    int chunk_z = 0;
+    /// \brief Compressed data of the chunk
+    CompressedChunk data;
+    /// \brief Occupancy of the chunk, if it is cached
+    std::optional<ChunkOccupancy> cached;
+};
+
+/// \brief A decompressed chunk, which has to be decoded
+struct DecompressedChunk {
+    /// \brief x coordinate of the chunk
+    int chunk_x = 0;
+    /// \brief z coordinate of the chunk
+    int chunk_z = 0;
+    /// \brief Timestamp of the chunk in its region file
+    std::uint32_t timestamp = 0;
+    /// \brief NBT data of the chunk, empty if it is cached
+    std::vector<unsigned char> data;
+    /// \brief Occupancy of the chunk, if it is cached
+    std::optional<ChunkOccupancy> cached;
+};
+
+/// \brief Solid blocks of a decoded chunk
+struct DecodedChunk {
+    /// \brief x coordinate of the chunk
+    int chunk_x = 0;
+    /// \brief z coordinate of the chunk
+    int chunk_z = 0;
+    /// \brief Timestamp of the chunk in its region file
+    std::uint32_t timestamp = 0;
+    /// \brief Occupancy of the chunk within bounds
+    ChunkOccupancy blocks;
+    /// \brief Occupancy of the whole chunk, if it has to be cached
+    std::optional<ChunkOccupancy> uncached;
+};
+
+/// \brief Decodes occupancy of sections of a chunk within y bounds
+///
+/// Entries of the palette of every section are classified once, and
+/// packed block states are unpacked directly into occupancy bits.
+/// Sections outside of the bounds, above the highest block given by
+/// the heightmap of the chunk, or with a palette of only solid or only
+/// empty blocks, are not unpacked at all.
+///
+/// \param data NBT data of the chunk
+/// \param lower_y Lower bound on y, inclusive
+/// \param upper_y Upper bound on y, exclusive
+/// \param filter Classification of blocks
+ChunkOccupancy decode_chunk(
+    std::span<unsigned char const> data,
+    int lower_y,
+    int upper_y,
+    BlockFilter const& filter
+) {
+    ChunkOccupancy occupancy;
+    auto const root = NbtView::root(data);
+    // the heightmap bounds only non-air blocks
+    if (!filter.has_solid_air()) {
+        if (auto const top = highest_block(root)) {
+            upper_y = std::min(upper_y, *top + 1);
+        }
+    }
+    auto const sections = chunk_sections(root);
+    if (upper_y <= lower_y || !sections) {
+        return occupancy;
+    }
+    // buffers reused by all sections of the chunk
+    std::vector<bool> solid;
+    std::vector<std::uint64_t> block_states;
+    for (auto const element : *sections) {
+        auto const section = read_section(element);
+        if (!section || 16 * section->y + 16 <= lower_y
+            || 16 * section->y >= upper_y) {
+            continue;
+        }
+        solid.clear();
+        for (auto const entry : section->palette) {
+            auto const name = entry.find("Name");
+            solid.push_back(name && filter.is_solid(name->as_string()));
+        }
+        auto const solid_count = std::ranges::count(solid, true);
+        if (solid_count == 0) {
+            continue;
+        }
+        occupancy.push_back({.y = section->y});
+        auto& blocks = occupancy.back().blocks;
+        // block states are needed only to tell apart solid and empty
+        // blocks
+        if (static_cast<std::size_t>(solid_count) == solid.size()) {
+            blocks.fill(~std::uint64_t {0});
+            continue;
+        }
+        block_states.clear();
+        if (section->data) {
+            section->data->as_long_array(block_states);
+        }
+        blocks = unpack_occupancy(block_states, solid);
+    }
+    return occupancy;
+}
+
+/// \brief Clears blocks of a chunk outside of bounds
+///
+/// Sections left empty are removed.
+void clip_chunk(
+    ChunkOccupancy& occupancy,
+    int chunk_x,
+    int chunk_z,
     MinecraftCoordinates lower_corner,
     MinecraftCoordinates upper_corner
 ) {
-    CubicalComplex3D complex {};
+    // ranges of block coordinates within the chunk inside the bounds
+    auto const x_begin = std::max(lower_corner.x - 16 * chunk_x, 0);
+    auto const x_end = std::min(upper_corner.x - 16 * chunk_x, 16);
+    auto const z_begin = std::max(lower_corner.z - 16 * chunk_z, 0);
+    auto const z_end = std::min(upper_corner.z - 16 * chunk_z, 16);
+    // a word holds 4 rows of 16 blocks along x
+    std::uint64_t row = 0;
+    for (int x = x_begin; x < x_end; ++x) {
+        row |= std::uint64_t {1} << x;
+    }
+    for (auto& section : occupancy) {
+        auto const y_begin = std::max(lower_corner.y - 16 * section.y, 0);
+        auto const y_end = std::min(upper_corner.y - 16 * section.y, 16);
+        for (std::size_t word = 0; word < section.blocks.size(); ++word) {
+            auto const y = static_cast<int>(word / 4);
+            std::uint64_t mask = 0;
+            for (int r = 0; r < 4 && y >= y_begin && y < y_end; ++r) {
+                auto const z = static_cast<int>(word % 4 * 4) + r;
+                if (z >= z_begin && z < z_end) {
+                    mask |= row << (16 * r);
+                }
+            }
+            section.blocks[word] &= mask;
+        }
+    }
+    std::erase_if(occupancy, [](OccupiedSection const& section) {
+        return std::ranges::all_of(section.blocks, [](std::uint64_t word) {
+            return word == 0;
+        });
+    });
+}
+
+/// \brief Reads solid blocks of chunks decoded in a pipeline
+///
+/// The stages run concurrently and are connected by bounded queues:
+/// a reader looking up chunks in region files, decompressors, decoders
+/// of sections and the calling thread adding sections to the grid. So
+/// the parsing takes about as long as its slowest stage. Worker threads
+/// are split between decompression and decoding, a single worker does
+/// both. The first exception thrown by a stage closes all queues and is
+/// rethrown once all stages finish.
+///
+/// With a cache, the reader takes chunks from the cache, which then
+/// skip decompression and decoding, and the other chunks are decoded
+/// whole and added to the cache.
+complexes::VoxelGrid read_voxels(
+    std::filesystem::path const& path,
+    MinecraftCoordinates lower_corner,
+    MinecraftCoordinates upper_corner,
+    unsigned threads,
+    BlockFilter const& filter,
+    VoxelCache* cache
+) {
+    RegionDirectory regions(path);
     auto const [lower_chunk_x, lower_chunk_z] =
         get_lower_chunk_coords(lower_corner.x, lower_corner.z);
     auto const [upper_chunk_x, upper_chunk_z] =
         get_upper_chunk_coords(upper_corner.x, upper_corner.z);
-    for (int chunk_x = lower_chunk_x; chunk_x < upper_chunk_x; ++chunk_x) {
-        for (int chunk_z = lower_chunk_z; chunk_z < upper_chunk_z; ++chunk_z) {
-            // we const cast, because the original C API doesn't accept const char*
-            // it's fine, because extractChunk doesnt modify the name
-            auto chunk =
-                extractChunk(const_cast<char*>(path.c_str()), chunk_x, chunk_z);
-            std::vector<section> sections(maxSections);
-            auto count =
-                getSections(chunk.data, chunk.byteLength, sections.data());
-            sections.resize(count);
-            for (auto const& section : sections) {
-                int out_len = 0;
-                unsigned* block_states = getBlockStates(section, &out_len);
-                for (int y = 0; y < 16; ++y) {
-                    // out of range
-                    if (!(lower_corner.y <= 16 * section.y + y
-                          && 16 * section.y + y < upper_corner.y)) {
+    // cached chunks are reused for any bounds
+    auto const lower_y =
+        cache ? std::numeric_limits<int>::min() : lower_corner.y;
+    auto const upper_y =
+        cache ? std::numeric_limits<int>::max() : upper_corner.y;
+    auto const capacity = 4 * std::size_t {std::max(threads, 1u)};
+    BoundedQueue<ChunkJob> compressed(capacity);
+    BoundedQueue<DecompressedChunk> decompressed(capacity);
+    BoundedQueue<DecodedChunk> decoded(capacity);
+    std::exception_ptr error = nullptr;
+    std::mutex error_mutex;
+    auto const fail = [&] {
+        {
+            std::scoped_lock lock(error_mutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+        compressed.close();
+        decompressed.close();
+        decoded.close();
+    };
+    auto const decompress = [](ChunkJob job) {
+        DecompressedChunk chunk = {
+            .chunk_x = job.chunk_x,
+            .chunk_z = job.chunk_z,
+            .timestamp = job.data.timestamp,
+            .data = {},
+            .cached = std::move(job.cached),
+        };
+        if (!chunk.cached) {
+            chunk.data = decompress_chunk(job.data);
+        }
+        return chunk;
+    };
+    auto const decode = [&](DecompressedChunk job) {
+        auto const is_cached = job.cached.has_value();
+        auto occupancy = is_cached
+            ? std::move(*job.cached)
+            : decode_chunk(job.data, lower_y, upper_y, filter);
+        DecodedChunk chunk = {
+            .chunk_x = job.chunk_x,
+            .chunk_z = job.chunk_z,
+            .timestamp = job.timestamp,
+            .blocks = occupancy,
+            .uncached = std::nullopt,
+        };
+        clip_chunk(
+            chunk.blocks,
+            job.chunk_x,
+            job.chunk_z,
+            lower_corner,
+            upper_corner
+        );
+        if (cache && !is_cached) {
+            chunk.uncached = std::move(occupancy);
+        }
+        return chunk;
+    };
+    // a single worker both decompresses and decodes, so that the
+    // number of workers is exactly the requested number of threads
+    auto const split = threads > 1;
+    auto const decompressor_count = split ? threads / 2 : 0u;
+    auto const decoder_count = split ? threads - threads / 2 : 1u;
+    std::atomic<unsigned> active_decompressors = decompressor_count;
+    std::atomic<unsigned> active_decoders = decoder_count;
+    // declared last, so the threads are joined before anything they use
+    // is destroyed
+    std::vector<std::jthread> stages;
+    // the region directory is used only by the reader, so it stays
+    // single-threaded
+    stages.emplace_back([&] {
+        try {
+            for (int x = lower_chunk_x; x < upper_chunk_x; ++x) {
+                for (int z = lower_chunk_z; z < upper_chunk_z; ++z) {
+                    auto const chunk = regions.chunk(x, z);
+                    if (!chunk) {
                         continue;
                     }
-                    for (int x = 0; x < 16; ++x) {
-                        // out of range
-                        if (!(lower_corner.x <= 16 * chunk_x + x
-                              && 16 * chunk_x + x < upper_corner.x)) {
-                            continue;
+                    ChunkJob job = {
+                        .chunk_x = x,
+                        .chunk_z = z,
+                        .data = *chunk,
+                        .cached = std::nullopt,
+                    };
+                    if (cache) {
+                        job.cached = cache->find(x, z, chunk->timestamp);
+                    }
+                    if (!compressed.push(std::move(job))) {
+                        return;
+                    }
+                }
+            }
+        } catch (...) {
+            fail();
+        }
+        compressed.close();
+    });
+    for (unsigned t = 0; t < decompressor_count; ++t) {
+        stages.emplace_back([&] {
+            try {
+                while (auto job = compressed.pop()) {
+                    if (!decompressed.push(decompress(std::move(*job)))) {
+                        break;
+                    }
+                }
+            } catch (...) {
+                fail();
+            }
+            if (--active_decompressors == 0) {
+                decompressed.close();
+            }
+        });
+    }
+    for (unsigned t = 0; t < decoder_count; ++t) {
+        stages.emplace_back([&] {
+            try {
+                if (split) {
+                    while (auto job = decompressed.pop()) {
+                        if (!decoded.push(decode(std::move(*job)))) {
+                            break;
                         }
-                        for (int z = 0; z < 16; ++z) {
-                            // out of range
-                            if (!(lower_corner.z <= 16 * chunk_z + z
-                                  && 16 * chunk_z + z < upper_corner.z)) {
-                                continue;
-                            }
-                            auto block =
-                                createBlock(x, y, z, block_states, section);
-                            if (strcmp(block.type, mcAir) != 0) {
-                                complex.add_cube(
-                                    16 * chunk_x + x,
-                                    16 * section.y + y,
-                                    16 * chunk_z + z
-                                );
-                            }
+                    }
+                } else {
+                    while (auto job = compressed.pop()) {
+                        auto chunk = decode(decompress(std::move(*job)));
+                        if (!decoded.push(std::move(chunk))) {
+                            break;
                         }
                     }
                 }
-                free(block_states);
+            } catch (...) {
+                fail();
+            }
+            if (--active_decoders == 0) {
+                decoded.close();
+            }
+        });
+    }
+    // the grid doesn't depend on the order of insertion, so neither on
+    // the number of threads
+    complexes::VoxelGrid grid;
+    try {
+        while (auto chunk = decoded.pop()) {
+            if (chunk->uncached) {
+                cache->insert(
+                    chunk->chunk_x,
+                    chunk->chunk_z,
+                    chunk->timestamp,
+                    std::move(*chunk->uncached)
+                );
             }
-            // free sections frees inner data of sections and not the
-            // pointer itself, so we are safe
-            freeSections(sections.data(), sections.size());
-            free(chunk.data);
+            for (auto const& section : chunk->blocks) {
+                grid.insert_section(
+                    {.x = chunk->chunk_x, .y = section.y, .z = chunk->chunk_z},
+                    section.blocks
+                );
+            }
+        }
+    } catch (...) {
+        fail();
+    }
+    stages.clear();
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    if (cache) {
+        cache->flush();
+    }
+    return grid;
+}
+
+/// \brief Builds a complex from all runs of voxel columns
+template<class C>
+std::unique_ptr<Complex>
+build_complex(C complex, complexes::VoxelColumns const& columns) {
+    columns.for_each_run([&complex](int x, int z, complexes::Run run) {
+        for (int y = run.begin; y < run.end; ++y) {
+            complex.add_cube(x, y, z);
+        }
+    });
+    return std::make_unique<C>(std::move(complex));
+}
+
+} // namespace
+
+MinecraftSavefileParser::~MinecraftSavefileParser() = default;
+
+MinecraftSavefileParser_mcSavefileParsers::
+    MinecraftSavefileParser_mcSavefileParsers(
+        HomologyEngine engine,
+        unsigned threads,
+        BlockFilter filter,
+        std::optional<std::filesystem::path> cache_directory
+    ) :
+    m_engine(engine),
+    m_threads(threads),
+    m_filter(std::move(filter)),
+    m_cache_directory(std::move(cache_directory)) {}
+
+complexes::VoxelGrid MinecraftSavefileParser_mcSavefileParsers::parse_voxels(
+    std::filesystem::path const& path,
+    MinecraftCoordinates lower_corner,
+    MinecraftCoordinates upper_corner
+) {
+    std::optional<VoxelCache> cache;
+    if (m_cache_directory) {
+        cache.emplace(*m_cache_directory, path, m_filter.fingerprint());
+    }
+    return read_voxels(
+        path,
+        lower_corner,
+        upper_corner,
+        m_threads,
+        m_filter,
+        cache ? &*cache : nullptr
+    );
+}
+
+std::unique_ptr<Complex> MinecraftSavefileParser_mcSavefileParsers::parse(
+    std::filesystem::path const& path,
+    MinecraftCoordinates lower_corner,
+    MinecraftCoordinates upper_corner
+) {
+    // layers without a transition between solid and empty blocks are
+    // squeezed into one, so complexes grow with the number of
+    // transitions instead of the height of the bounds
+    auto const columns =
+        complexes::VoxelColumns(parse_voxels(path, lower_corner, upper_corner))
+            .compress_y();
+    switch (m_engine) {
+        case HomologyEngine::Matrix: {
+            return build_complex(CubicalComplex3D {}, columns);
+        }
+        case HomologyEngine::Bitmap: {
+            // the bitmap spans only the voxels, not the whole bounds
+            auto const [lower, upper] = columns.bounding_box().value_or(
+                std::pair<complexes::Voxel, complexes::Voxel> {}
+            );
+            return build_complex(BitmapComplex3D(lower, upper), columns);
+        }
+        case HomologyEngine::Voxel: {
+            return build_complex(VoxelComplex3D {}, columns);
         }
     }
-    return std::make_unique<CubicalComplex3D>(std::move(complex));
+    throw std::logic_error("Unknown homology engine");
 }
 
 } // namespace core
@@ -0,0 +1,188 @@
+#include "../include/core/region_file.h"
+
+#include <algorithm>
+#include <format>
+#include <stdexcept>
+
+#include <zlib.h>
+
+namespace {
+
+/// \brief Size of a sector of a region file, also the size of the
+///        location table and of the timestamp table
+constexpr std::size_t sector_size = 4096;
+
+/// \brief Size of the header of a chunk: length and compression
+constexpr std::size_t chunk_header_size = 5;
+
+/// \brief Flag of the compression byte marking chunks stored in
+///        separate .mcc files
+constexpr std::uint8_t external_chunk_flag = 0x80;
+
+std::uint32_t read_big_endian_32(std::span<std::byte const> bytes) {
+    return (std::to_integer<std::uint32_t>(bytes[0]) << 24)
+        | (std::to_integer<std::uint32_t>(bytes[1]) << 16)
+        | (std::to_integer<std::uint32_t>(bytes[2]) << 8)
+        | std::to_integer<std::uint32_t>(bytes[3]);
+}
+
+/// \brief A zlib stream, which is ended on destruction
+class InflateStream {
+public:
+    InflateStream() {
+        // 32 enables automatic detection of zlib and gzip headers
+        if (inflateInit2(&m_stream, 15 + 32) != Z_OK) {
+            throw std::runtime_error("Cannot initialize zlib");
+        }
+    }
+
+    InflateStream(InflateStream const&) = delete;
+    InflateStream& operator=(InflateStream const&) = delete;
+
+    ~InflateStream() {
+        inflateEnd(&m_stream);
+    }
+
+    z_stream* operator->() {
+        return &m_stream;
+    }
+
+private:
+    z_stream m_stream {};
+};
+
+std::vector<unsigned char> inflate_chunk(std::span<std::byte const> data) {
+    InflateStream stream;
+    // zlib doesn't modify the input, it just isn't const-correct
+    stream->next_in =
+        reinterpret_cast<Bytef*>(const_cast<std::byte*>(data.data()));
+    stream->avail_in = static_cast<uInt>(data.size());
+    // chunk NBT usually compresses a few times
+    std::vector<unsigned char> output(4 * data.size() + sector_size);
+    while (true) {
+        if (stream->total_out == output.size()) {
+            output.resize(2 * output.size());
+        }
+        stream->next_out = output.data() + stream->total_out;
+        stream->avail_out =
+            static_cast<uInt>(output.size() - stream->total_out);
+        auto const result = inflate(stream.operator->(), Z_NO_FLUSH);
+        if (result == Z_STREAM_END) {
+            break;
+        }
+        if (result != Z_OK && !(result == Z_BUF_ERROR && stream->avail_in)) {
+            throw std::runtime_error("Corrupted chunk data");
+        }
+    }
+    output.resize(stream->total_out);
+    return output;
+}
+
+} // namespace
+
+namespace core {
+
+std::vector<unsigned char> decompress_chunk(CompressedChunk chunk) {
+    switch (chunk.compression) {
+        case ChunkCompression::Gzip:
+        case ChunkCompression::Zlib: {
+            return inflate_chunk(chunk.data);
+        }
+        case ChunkCompression::None: {
+            std::vector<unsigned char> output(chunk.data.size());
+            std::ranges::transform(chunk.data, output.begin(), [](std::byte b) {
+                return std::to_integer<unsigned char>(b);
+            });
+            return output;
+        }
+        case ChunkCompression::Lz4: {
+            break;
+        }
+    }
+    throw std::runtime_error("Unsupported chunk compression");
+}
+
+RegionFile::RegionFile(std::filesystem::path const& path) :
+    m_file(path) {
+    auto const data = m_file.data();
+    // the game creates empty region files, which contain no chunks
+    if (data.empty()) {
+        return;
+    }
+    if (data.size() < 2 * sector_size) {
+        throw std::runtime_error(
+            std::format("Malformed region file {}", path.string())
+        );
+    }
+    for (std::size_t i = 0; i < m_locations.size(); ++i) {
+        m_locations[i] = read_big_endian_32(data.subspan(4 * i, 4));
+        m_timestamps[i] =
+            read_big_endian_32(data.subspan(sector_size + 4 * i, 4));
+    }
+}
+
+std::optional<CompressedChunk>
+RegionFile::chunk(int local_x, int local_z) const {
+    if (local_x < 0 || local_x >= chunks_per_side || local_z < 0
+        || local_z >= chunks_per_side) [[unlikely]] {
+        throw std::out_of_range("Chunk coordinates outside of the region");
+    }
+    auto const index = local_x + chunks_per_side * local_z;
+    auto const location = m_locations[index];
+    auto const data = m_file.data();
+    // the location consists of an offset in sectors on 3 bytes and
+    // a number of sectors on 1 byte
+    auto const offset = std::size_t {location >> 8} * sector_size;
+    auto const sectors = location & 0xff;
+    if (offset == 0 || sectors == 0) {
+        return std::nullopt;
+    }
+    if (offset + chunk_header_size > data.size()) {
+        throw std::runtime_error("Chunk outside of the region file");
+    }
+    auto const length = read_big_endian_32(data.subspan(offset, 4));
+    if (length == 0 || offset + 4 + length > data.size()) {
+        throw std::runtime_error("Chunk outside of the region file");
+    }
+    auto const compression =
+        std::to_integer<std::uint8_t>(data[offset + 4]);
+    if (compression & external_chunk_flag) {
+        throw std::runtime_error(
+            "Chunks stored in external files are not supported"
+        );
+    }
+    return CompressedChunk {
+        .compression = static_cast<ChunkCompression>(compression),
+        .data = data.subspan(offset + chunk_header_size, length - 1),
+        .timestamp = m_timestamps[index],
+    };
+}
+
+RegionDirectory::RegionDirectory(std::filesystem::path directory) :
+    m_directory(std::move(directory)) {}
+
+std::optional<CompressedChunk>
+RegionDirectory::chunk(int chunk_x, int chunk_z) {
+    // arithmetic shifts round towards negative infinity, as the game
+    // does for negative coordinates
+    std::pair const region = {chunk_x >> 5, chunk_z >> 5};
+    auto it = m_regions.find(region);
+    if (it == m_regions.end()) {
+        auto const path = m_directory
+            / std::format("r.{}.{}.mca", region.first, region.second);
+        std::unique_ptr<RegionFile> file;
+        if (std::filesystem::exists(path)) {
+            file = std::make_unique<RegionFile>(path);
+        }
+        it = m_regions.emplace(region, std::move(file)).first;
+    }
+    if (!it->second) {
+        return std::nullopt;
+    }
+    return it->second->chunk(
+        chunk_x & (RegionFile::chunks_per_side - 1),
+        chunk_z & (RegionFile::chunks_per_side - 1)
+    );
+}
+
+} // namespace core
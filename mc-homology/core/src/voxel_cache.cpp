@@ -0,0 +1,280 @@
+#include "../include/core/voxel_cache.h"
+
+#include <array>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "core/region_file.h"
+
+namespace {
+
+using core::ChunkOccupancy;
+using core::OccupiedSection;
+using core::SectionOccupancy;
+
+/// \brief Number of chunks in a region
+constexpr std::size_t chunks_per_region =
+    core::RegionFile::chunks_per_side * core::RegionFile::chunks_per_side;
+
+/// \brief Header of a cache file
+struct FileHeader {
+    /// \brief Identification of the file format
+    std::array<char, 8> magic;
+    /// \brief Version of the file format
+    std::uint32_t version;
+    /// \brief A constant, which reads differently in another byte order
+    std::uint32_t byte_order;
+    /// \brief Hash of the canonical path of the region directory
+    std::uint64_t source;
+    /// \brief Fingerprint of the block filter
+    std::uint64_t fingerprint;
+};
+
+/// \brief Location of a cached chunk in a cache file
+struct ChunkEntry {
+    /// \brief Timestamp of the chunk in its region file
+    std::uint32_t timestamp;
+    /// \brief Number of non-empty sections
+    std::uint32_t section_count;
+    /// \brief Offset of the sections in the file, 0 for absent chunks
+    std::uint64_t offset;
+};
+
+/// \brief A cached non-empty section
+struct SectionRecord {
+    /// \brief y coordinate of the section, in sections
+    std::int32_t y;
+    std::uint32_t padding;
+    /// \brief Occupancy of blocks of the section
+    SectionOccupancy blocks;
+};
+
+constexpr FileHeader expected_header = {
+    .magic = {'M', 'C', 'H', 'V', 'O', 'X', 'E', 'L'},
+    .version = 2,
+    .byte_order = 0x01020304,
+    .source = 0,
+    .fingerprint = 0,
+};
+
+constexpr std::size_t index_offset = sizeof(FileHeader);
+
+constexpr std::size_t data_offset =
+    index_offset + chunks_per_region * sizeof(ChunkEntry);
+
+/// \brief Returns a hash of the canonical path of a directory
+///
+/// The path is made canonical, so that different spellings of the same
+/// directory share cache files.
+std::uint64_t path_hash(std::filesystem::path const& directory) {
+    // 64-bit FNV-1a, as BlockFilter::fingerprint()
+    std::uint64_t hash = 0xcbf29ce484222325;
+    for (auto c : std::filesystem::weakly_canonical(directory).string()) {
+        hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001b3;
+    }
+    return hash;
+}
+
+/// \brief Copies a trivially copyable object out of a file
+template<class T>
+T read(std::span<std::byte const> data, std::size_t offset) {
+    T value;
+    std::memcpy(&value, data.data() + offset, sizeof(T));
+    return value;
+}
+
+/// \brief Reads an entry of a chunk, if its sections are in the file
+std::optional<ChunkEntry>
+read_entry(std::span<std::byte const> data, std::size_t chunk) {
+    auto const entry =
+        read<ChunkEntry>(data, index_offset + chunk * sizeof(ChunkEntry));
+    if (entry.offset == 0 || entry.offset > data.size()
+        || (data.size() - entry.offset) / sizeof(SectionRecord)
+            < entry.section_count) {
+        return std::nullopt;
+    }
+    return entry;
+}
+
+/// \brief Appends bytes of a trivially copyable object to a buffer
+template<class T>
+void write(std::vector<std::byte>& buffer, T const& value) {
+    auto const bytes = std::as_bytes(std::span(&value, 1));
+    buffer.insert(buffer.end(), bytes.begin(), bytes.end());
+}
+
+} // namespace
+
+namespace core {
+
+VoxelCache::VoxelCache(
+    std::filesystem::path directory,
+    std::filesystem::path const& region_directory,
+    std::uint64_t fingerprint
+) :
+    m_directory(std::move(directory)),
+    m_source(path_hash(region_directory)),
+    m_fingerprint(fingerprint) {
+    std::filesystem::create_directories(m_directory);
+}
+
+std::optional<ChunkOccupancy>
+VoxelCache::find(int chunk_x, int chunk_z, std::uint32_t timestamp) {
+    auto const* cache = file({chunk_x >> 5, chunk_z >> 5});
+    if (!cache) {
+        return std::nullopt;
+    }
+    auto const data = cache->data();
+    auto const chunk = static_cast<std::size_t>(
+        (chunk_x & (RegionFile::chunks_per_side - 1))
+        + RegionFile::chunks_per_side
+            * (chunk_z & (RegionFile::chunks_per_side - 1))
+    );
+    auto const entry = read_entry(data, chunk);
+    if (!entry || entry->timestamp != timestamp) {
+        return std::nullopt;
+    }
+    ChunkOccupancy occupancy(entry->section_count);
+    for (std::size_t i = 0; i < occupancy.size(); ++i) {
+        auto const record = read<SectionRecord>(
+            data,
+            entry->offset + i * sizeof(SectionRecord)
+        );
+        occupancy[i] = {.y = record.y, .blocks = record.blocks};
+    }
+    return occupancy;
+}
+
+void VoxelCache::insert(
+    int chunk_x,
+    int chunk_z,
+    std::uint32_t timestamp,
+    ChunkOccupancy occupancy
+) {
+    auto const chunk = static_cast<std::size_t>(
+        (chunk_x & (RegionFile::chunks_per_side - 1))
+        + RegionFile::chunks_per_side
+            * (chunk_z & (RegionFile::chunks_per_side - 1))
+    );
+    m_pending[{chunk_x >> 5, chunk_z >> 5}][chunk] = {
+        .timestamp = timestamp,
+        .occupancy = std::move(occupancy),
+    };
+}
+
+void VoxelCache::flush() {
+    for (auto& [region, chunks] : m_pending) {
+        auto const* old = file(region);
+        std::vector<std::byte> buffer;
+        auto header = expected_header;
+        header.source = m_source;
+        header.fingerprint = m_fingerprint;
+        write(buffer, header);
+        buffer.resize(data_offset);
+        for (std::size_t chunk = 0; chunk < chunks_per_region; ++chunk) {
+            ChunkEntry entry = {};
+            if (auto const it = chunks.find(chunk); it != chunks.end()) {
+                entry = {
+                    .timestamp = it->second.timestamp,
+                    .section_count = static_cast<std::uint32_t>(
+                        it->second.occupancy.size()
+                    ),
+                    .offset = buffer.size(),
+                };
+                for (auto const& section : it->second.occupancy) {
+                    write(
+                        buffer,
+                        SectionRecord {
+                            .y = section.y,
+                            .padding = 0,
+                            .blocks = section.blocks,
+                        }
+                    );
+                }
+            } else if (old) {
+                auto const old_entry = read_entry(old->data(), chunk);
+                if (!old_entry) {
+                    continue;
+                }
+                auto const records = old->data().subspan(
+                    old_entry->offset,
+                    old_entry->section_count * sizeof(SectionRecord)
+                );
+                entry = *old_entry;
+                entry.offset = buffer.size();
+                buffer.insert(buffer.end(), records.begin(), records.end());
+            } else {
+                continue;
+            }
+            std::memcpy(
+                buffer.data() + index_offset + chunk * sizeof(ChunkEntry),
+                &entry,
+                sizeof(entry)
+            );
+        }
+        // the old file stays mapped until the new one is complete, then
+        // it is replaced at once
+        auto const target = path(region);
+        auto temporary = target;
+        temporary += ".tmp";
+        {
+            std::ofstream output(temporary, std::ios::binary);
+            output.write(
+                reinterpret_cast<char const*>(buffer.data()),
+                static_cast<std::streamsize>(buffer.size())
+            );
+            if (!output) {
+                throw std::runtime_error(std::format(
+                    "Cannot write voxel cache {}",
+                    temporary.string()
+                ));
+            }
+        }
+        m_files.erase(region);
+        std::filesystem::rename(temporary, target);
+    }
+    m_pending.clear();
+}
+
+std::filesystem::path VoxelCache::path(Region region) const {
+    return m_directory
+        / std::format(
+               "r.{}.{}.{:016x}.{:016x}.voxels",
+               region.first,
+               region.second,
+               m_source,
+               m_fingerprint
+        );
+}
+
+MappedFile const* VoxelCache::file(Region region) {
+    auto it = m_files.find(region);
+    if (it == m_files.end()) {
+        auto const path = this->path(region);
+        std::unique_ptr<MappedFile> file;
+        if (std::filesystem::exists(path)) {
+            file = std::make_unique<MappedFile>(path);
+            auto const data = file->data();
+            if (data.size() < data_offset) {
+                file.reset();
+            } else {
+                auto const header = read<FileHeader>(data, 0);
+                if (header.magic != expected_header.magic
+                    || header.version != expected_header.version
+                    || header.byte_order != expected_header.byte_order
+                    || header.source != m_source
+                    || header.fingerprint != m_fingerprint) {
+                    file.reset();
+                }
+            }
+        }
+        it = m_files.emplace(region, std::move(file)).first;
+    }
+    return it->second.get();
+}
+
+} // namespace core
@@ -0,0 +1,38 @@
+#include "../include/core/voxel_complex_3d.h"
+
+#include <algorithm>
+
+#include "algebra/dynamic_modulo_field.h"
+#include "algebra/integer.h"
+#include "algebra/z2_field.h"
+
+namespace core {
+
+void VoxelComplex3D::add_cube(int x, int y, int z) {
+    m_voxels.push_back({.x = x, .y = y, .z = z});
+}
+
+std::unique_ptr<Homology> VoxelComplex3D::z2_homology() const {
+    return homology<algebra::Z2>();
+}
+
+std::unique_ptr<Homology> VoxelComplex3D::z3_homology() const {
+    return homology<algebra::ZModP<3>>();
+}
+
+std::unique_ptr<Homology> VoxelComplex3D::zp_homology(std::uint64_t p) const {
+    algebra::DynamicZModP::Modulus const modulus(p);
+    return homology<algebra::DynamicZModP>();
+}
+
+std::unique_ptr<Homology> VoxelComplex3D::z_homology() const {
+    return homology<algebra::Integer>();
+}
+
+void VoxelComplex3D::reduce() {
+    std::ranges::sort(m_voxels);
+    auto [first, last] = std::ranges::unique(m_voxels);
+    m_voxels.erase(first, last);
+}
+
+} // namespace core
@@ -0,0 +1,20 @@
+#include "core/block_filter.h"
+
+#include <gtest/gtest.h>
+
+using namespace core;
+
+TEST(BlockFilterTest, Fingerprint) {
+    BlockFilter const stone({"stone"});
+    EXPECT_TRUE(stone.is_solid("minecraft:stone"));
+    EXPECT_FALSE(stone.is_solid("minecraft:dirt"));
+    EXPECT_EQ(
+        BlockFilter({"stone", "minecraft:stone"}).fingerprint(),
+        stone.fingerprint()
+    );
+    EXPECT_EQ(
+        BlockFilter({"dirt", "stone"}).fingerprint(),
+        BlockFilter({"minecraft:stone", "dirt"}).fingerprint()
+    );
+    EXPECT_NE(BlockFilter({"dirt"}).fingerprint(), stone.fingerprint());
+}
@@ -0,0 +1,138 @@
+#include "core/block_states.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace core;
+
+namespace {
+
+/// \brief Packs palette indices the way the game does
+std::vector<std::uint64_t> pack(
+    std::vector<std::uint16_t> const& indices,
+    std::size_t palette_size
+) {
+    auto const bits = bits_per_block(palette_size);
+    auto const per_word = 64 / bits;
+    std::vector<std::uint64_t> data(
+        (indices.size() + per_word - 1) / per_word
+    );
+    for (std::size_t i = 0; i < indices.size(); ++i) {
+        data[i / per_word] |= std::uint64_t {indices[i]}
+            << (i % per_word * bits);
+    }
+    return data;
+}
+
+std::vector<std::uint16_t> random_indices(std::size_t palette_size) {
+    std::mt19937 generator(static_cast<unsigned>(palette_size));
+    std::uniform_int_distribution<std::uint16_t> distribution(
+        0,
+        static_cast<std::uint16_t>(palette_size - 1)
+    );
+    std::vector<std::uint16_t> indices(blocks_per_section);
+    for (auto& index : indices) {
+        index = distribution(generator);
+    }
+    return indices;
+}
+
+/// \brief A version of the unpacking functions
+struct Unpacking {
+    char const* name;
+    decltype(&unpack_block_states) block_states;
+    decltype(&unpack_occupancy) occupancy;
+};
+
+/// \brief The dispatched versions, vectorized on processors with AVX2,
+///        and the scalar ones
+constexpr std::array<Unpacking, 2> unpackings = {{
+    {"dispatched", unpack_block_states, unpack_occupancy},
+    {"scalar",
+     detail::unpack_block_states_scalar,
+     detail::unpack_occupancy_scalar},
+}};
+
+} // namespace
+
+TEST(BlockStatesTest, BitsPerBlock) {
+    EXPECT_EQ(bits_per_block(2), 4);
+    EXPECT_EQ(bits_per_block(16), 4);
+    EXPECT_EQ(bits_per_block(17), 5);
+    EXPECT_EQ(bits_per_block(64), 6);
+    EXPECT_EQ(bits_per_block(65), 7);
+}
+
+TEST(BlockStatesTest, UnpackBlockStates) {
+    for (auto const& unpacking : unpackings) {
+        for (std::size_t palette_size :
+             {2, 5, 16, 17, 33, 64, 65, 300, 4096}) {
+            auto const expected = random_indices(palette_size);
+            auto const data = pack(expected, palette_size);
+            std::array<std::uint16_t, blocks_per_section> indices {};
+            unpacking.block_states(data, palette_size, indices);
+            EXPECT_TRUE(std::ranges::equal(indices, expected))
+                << unpacking.name << " " << palette_size;
+        }
+    }
+}
+
+TEST(BlockStatesTest, UnpackOccupancy) {
+    for (auto const& unpacking : unpackings) {
+        for (std::size_t palette_size : {2, 5, 16, 17, 33, 64, 65, 300}) {
+            auto const indices = random_indices(palette_size);
+            auto const data = pack(indices, palette_size);
+            std::vector<bool> solid(palette_size);
+            for (std::size_t i = 0; i < palette_size; ++i) {
+                solid[i] = i % 3 == 1;
+            }
+            auto const occupancy = unpacking.occupancy(data, solid);
+            for (std::size_t block = 0; block < blocks_per_section; ++block) {
+                ASSERT_EQ(
+                    is_occupied(occupancy, block),
+                    solid[indices[block]]
+                ) << unpacking.name
+                  << " " << palette_size << " " << block;
+            }
+        }
+    }
+}
+
+TEST(BlockStatesTest, SingleEntryPalette) {
+    for (auto const& unpacking : unpackings) {
+        std::array<std::uint16_t, blocks_per_section> indices;
+        indices.fill(1);
+        unpacking.block_states({}, 1, indices);
+        EXPECT_TRUE(std::ranges::all_of(indices, [](auto i) {
+            return i == 0;
+        })) << unpacking.name;
+        auto const full = unpacking.occupancy({}, {true});
+        EXPECT_TRUE(std::ranges::all_of(full, [](auto w) { return !~w; }))
+            << unpacking.name;
+        auto const empty = unpacking.occupancy({}, {false});
+        EXPECT_TRUE(std::ranges::all_of(empty, [](auto w) { return !w; }))
+            << unpacking.name;
+    }
+}
+
+TEST(BlockStatesTest, ShortData) {
+    std::vector<std::uint64_t> const data(255);
+    std::array<std::uint16_t, blocks_per_section> indices;
+    for (auto const& unpacking : unpackings) {
+        EXPECT_THROW(
+            unpacking.block_states(data, 2, indices),
+            std::runtime_error
+        ) << unpacking.name;
+        EXPECT_THROW(
+            unpacking.occupancy(data, {true, false}),
+            std::runtime_error
+        ) << unpacking.name;
+    }
+}
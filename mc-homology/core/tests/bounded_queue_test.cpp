@@ -0,0 +1,56 @@
+#include "core/bounded_queue.h"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace core;
+
+TEST(BoundedQueueTest, Order) {
+    BoundedQueue<int> queue(3);
+    EXPECT_TRUE(queue.push(1));
+    EXPECT_TRUE(queue.push(2));
+    EXPECT_EQ(queue.pop(), 1);
+    EXPECT_TRUE(queue.push(3));
+    EXPECT_EQ(queue.pop(), 2);
+    EXPECT_EQ(queue.pop(), 3);
+}
+
+TEST(BoundedQueueTest, Close) {
+    BoundedQueue<int> queue(2);
+    EXPECT_TRUE(queue.push(1));
+    queue.close();
+    queue.close();
+    EXPECT_FALSE(queue.push(2));
+    EXPECT_EQ(queue.pop(), 1);
+    EXPECT_EQ(queue.pop(), std::nullopt);
+}
+
+TEST(BoundedQueueTest, ZeroCapacity) {
+    EXPECT_THROW(BoundedQueue<int>(0), std::invalid_argument);
+}
+
+TEST(BoundedQueueTest, ProducerConsumer) {
+    constexpr int count = 10000;
+    BoundedQueue<int> queue(4);
+    std::vector<int> received;
+    {
+        std::jthread consumer([&] {
+            while (auto value = queue.pop()) {
+                received.push_back(*value);
+            }
+        });
+        for (int i = 0; i < count; ++i) {
+            EXPECT_TRUE(queue.push(i));
+        }
+        queue.close();
+    }
+    ASSERT_EQ(received.size(), std::size_t {count});
+    for (int i = 0; i < count; ++i) {
+        EXPECT_EQ(received[static_cast<std::size_t>(i)], i);
+    }
+}
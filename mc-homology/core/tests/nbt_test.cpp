@@ -0,0 +1,146 @@
+#include "core/nbt.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include "test_world.h"
+
+using namespace core;
+using test::NbtWriter;
+
+namespace {
+
+/// \brief Packs 256 heights of 9 bits the way the game does
+std::vector<std::uint64_t> pack_heights(std::vector<std::uint64_t> heights) {
+    std::vector<std::uint64_t> data(37);
+    for (std::size_t i = 0; i < heights.size(); ++i) {
+        data[i / 7] |= heights[i] << (i % 7 * 9);
+    }
+    return data;
+}
+
+} // namespace
+
+TEST(NbtTest, Find) {
+    NbtWriter writer;
+    writer.begin(NbtTag::Compound, "")
+        .begin(NbtTag::String, "Status")
+        .integer(4, 2)
+        .integer('f', 1)
+        .integer('u', 1)
+        .integer('l', 1)
+        .integer('l', 1)
+        .begin(NbtTag::List, "sections")
+        .integer(static_cast<std::uint8_t>(NbtTag::Compound), 1)
+        .integer(2, 4)
+        .begin(NbtTag::Byte, "Y")
+        .integer(0xfc, 1)
+        .end()
+        .begin(NbtTag::Short, "Y")
+        .integer(0x0102, 2)
+        .end()
+        .begin(NbtTag::Int, "yPos")
+        .integer(0xfffffffc, 4)
+        .end();
+    auto const root = NbtView::root(writer.data());
+    EXPECT_EQ(root.tag(), NbtTag::Compound);
+    EXPECT_EQ(root.payload().size(), writer.data().size() - 3);
+    auto const y = root.find("yPos");
+    ASSERT_TRUE(y.has_value());
+    EXPECT_EQ(y->as_integer(), -4);
+    EXPECT_FALSE(root.find("Y").has_value());
+    EXPECT_EQ(root.find("sections")->tag(), NbtTag::List);
+    EXPECT_THROW(root.find("Status")->as_integer(), std::runtime_error);
+    EXPECT_THROW(y->find("yPos"), std::runtime_error);
+    std::vector<std::int64_t> ys;
+    for (auto const section : *root.find("sections")) {
+        ys.push_back(section.find("Y")->as_integer());
+    }
+    EXPECT_EQ(ys, (std::vector<std::int64_t> {-4, 0x0102}));
+}
+
+TEST(NbtTest, Malformed) {
+    NbtWriter writer;
+    writer.begin(NbtTag::Compound, "").begin(NbtTag::Int, "yPos").integer(1, 2);
+    EXPECT_THROW(NbtView::root(writer.data()).find("x"), std::runtime_error);
+}
+
+TEST(NbtTest, HighestBlock) {
+    std::vector<std::uint64_t> heights(256, 70);
+    heights[100] = 130;
+    NbtWriter writer;
+    writer.begin(NbtTag::Compound, "")
+        .begin(NbtTag::Int, "yPos")
+        .integer(static_cast<std::uint32_t>(-4), 4)
+        .begin(NbtTag::Compound, "Heightmaps")
+        .begin(NbtTag::LongArray, "WORLD_SURFACE")
+        .long_array(pack_heights(heights))
+        .end()
+        .end();
+    EXPECT_EQ(highest_block(NbtView::root(writer.data())), -64 + 130 - 1);
+}
+
+TEST(NbtTest, HighestBlockInLevel) {
+    NbtWriter writer;
+    writer.begin(NbtTag::Compound, "")
+        .begin(NbtTag::Compound, "Level")
+        .begin(NbtTag::Compound, "Heightmaps")
+        .begin(NbtTag::LongArray, "WORLD_SURFACE")
+        .long_array(pack_heights(std::vector<std::uint64_t>(256, 0)))
+        .end()
+        .end()
+        .end();
+    EXPECT_EQ(highest_block(NbtView::root(writer.data())), -1);
+}
+
+TEST(NbtTest, Sections) {
+    NbtWriter writer;
+    writer.begin(NbtTag::Compound, "")
+        .begin(NbtTag::List, "sections")
+        .integer(static_cast<std::uint8_t>(NbtTag::Compound), 1)
+        .integer(2, 4)
+        // a section without blocks
+        .begin(NbtTag::Byte, "Y")
+        .integer(0xff, 1)
+        .end()
+        .begin(NbtTag::Byte, "Y")
+        .integer(3, 1)
+        .begin(NbtTag::Compound, "block_states")
+        .begin(NbtTag::List, "palette")
+        .integer(static_cast<std::uint8_t>(NbtTag::Compound), 1)
+        .integer(1, 4)
+        .begin(NbtTag::String, "Name")
+        .integer(5, 2)
+        .integer('s', 1)
+        .integer('t', 1)
+        .integer('o', 1)
+        .integer('n', 1)
+        .integer('e', 1)
+        .end()
+        .end()
+        .end()
+        .end();
+    auto const sections = chunk_sections(NbtView::root(writer.data()));
+    ASSERT_TRUE(sections.has_value());
+    auto it = sections->begin();
+    EXPECT_FALSE(read_section(*it).has_value());
+    ++it;
+    auto const section = read_section(*it);
+    ASSERT_TRUE(section.has_value());
+    EXPECT_EQ(section->y, 3);
+    EXPECT_FALSE(section->data.has_value());
+    auto const entry = *section->palette.begin();
+    EXPECT_EQ(entry.find("Name")->as_string(), "stone");
+    ++it;
+    EXPECT_TRUE(it == sections->end());
+}
+
+TEST(NbtTest, NoHeightmap) {
+    NbtWriter writer;
+    writer.begin(NbtTag::Compound, "").end();
+    EXPECT_FALSE(highest_block(NbtView::root(writer.data())).has_value());
+}
@@ -0,0 +1,137 @@
+#include "core/parser.h"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "complexes/voxel_grid.h"
+#include "test_world.h"
+
+using namespace core;
+
+namespace {
+
+/// \brief A directory with a region file of 4x4 chunks
+///
+/// Every chunk has a section of random air, stone and dirt at y = 0,
+/// a section of stone at y = 2 and a section of air at y = 5.
+class ParserTest: public testing::Test {
+protected:
+    void SetUp() override {
+        std::filesystem::remove_all(m_directory);
+        std::filesystem::create_directories(m_directory);
+        std::uint64_t state = 1;
+        for (int x = 0; x < 4; ++x) {
+            for (int z = 0; z < 4; ++z) {
+                std::vector<std::uint16_t> indices(blocks_per_section);
+                for (auto& index : indices) {
+                    state = state * 6364136223846793005 + 1442695040888963407;
+                    index = static_cast<std::uint16_t>((state >> 33) % 3);
+                    m_solid_count += index != 0;
+                }
+                m_chunks.push_back({
+                    .x = x,
+                    .z = z,
+                    .timestamp = 1,
+                    .data = test::chunk_nbt({
+                        {
+                            .y = 0,
+                            .palette = {
+                                "minecraft:air",
+                                "minecraft:stone",
+                                "minecraft:dirt",
+                            },
+                            .indices = indices,
+                        },
+                        {.y = 2, .palette = {"minecraft:stone"}, .indices = {}},
+                        {.y = 5, .palette = {"minecraft:air"}, .indices = {}},
+                    }),
+                });
+                m_solid_count += blocks_per_section;
+            }
+        }
+        test::write_region_file(m_directory / "r.0.0.mca", m_chunks);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(m_directory);
+    }
+
+    /// \brief Reads solid blocks of all chunks between given y bounds
+    complexes::VoxelGrid parse(
+        unsigned threads,
+        std::optional<std::filesystem::path> cache_directory = std::nullopt,
+        int lower_y = -64,
+        int upper_y = 320
+    ) {
+        MinecraftSavefileParser_mcSavefileParsers parser(
+            HomologyEngine::Matrix,
+            threads,
+            {},
+            std::move(cache_directory)
+        );
+        return parser.parse_voxels(
+            m_directory,
+            {.x = 0, .y = lower_y, .z = 0},
+            {.x = 64, .y = upper_y, .z = 64}
+        );
+    }
+
+    std::filesystem::path const m_directory = test::test_directory();
+    std::vector<test::TestChunk> m_chunks;
+    std::size_t m_solid_count = 0;
+};
+
+} // namespace
+
+TEST_F(ParserTest, ThreadCount) {
+    auto const grid = parse(1);
+    EXPECT_EQ(grid.size(), m_solid_count);
+    EXPECT_EQ(parse(8), grid);
+    EXPECT_EQ(parse(3), grid);
+}
+
+TEST_F(ParserTest, Errors) {
+    // a truncated chunk in the middle of the region
+    m_chunks[7].data.resize(m_chunks[7].data.size() / 2);
+    test::write_region_file(m_directory / "r.0.0.mca", m_chunks);
+    EXPECT_THROW(parse(1), std::runtime_error);
+    EXPECT_THROW(parse(8), std::runtime_error);
+}
+
+TEST_F(ParserTest, Cache) {
+    auto const cache = m_directory / "cache";
+    // chunks are cached whole, so the second parse clips cached chunks
+    // to other bounds
+    for (auto [lower_y, upper_y] : {std::pair {-64, 320}, {4, 40}}) {
+        auto const uncached = parse(3, std::nullopt, lower_y, upper_y);
+        EXPECT_EQ(parse(3, cache, lower_y, upper_y), uncached);
+    }
+    auto const before = parse(1);
+
+    // a chunk changed without a new timestamp is served from the cache
+    m_chunks[5].data = test::chunk_nbt({
+        {.y = 1, .palette = {"minecraft:stone"}, .indices = {}},
+    });
+    test::write_region_file(m_directory / "r.0.0.mca", m_chunks);
+    EXPECT_EQ(parse(3, cache), before);
+
+    // with a new timestamp it is decoded again
+    ++m_chunks[5].timestamp;
+    test::write_region_file(m_directory / "r.0.0.mca", m_chunks);
+    auto const after = parse(1);
+    EXPECT_NE(after, before);
+    EXPECT_EQ(parse(3, cache), after);
+    EXPECT_EQ(parse(3, cache, 4, 40), parse(1, std::nullopt, 4, 40));
+
+    // recording the new chunk kept the other cached chunks
+    m_chunks[6].data = m_chunks[5].data;
+    test::write_region_file(m_directory / "r.0.0.mca", m_chunks);
+    EXPECT_EQ(parse(3, cache), after);
+}
@@ -0,0 +1,72 @@
+#include "core/region_file.h"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "test_world.h"
+
+using namespace core;
+
+namespace {
+
+/// \brief Writes a region file with chunks at given local coordinates
+///
+/// Chunk i contains the string "chunk i" and its timestamp is 1000 + i.
+void write_region_file(
+    std::filesystem::path const& path,
+    std::vector<std::pair<int, int>> const& chunks
+) {
+    std::vector<test::TestChunk> test_chunks;
+    for (std::size_t i = 0; i < chunks.size(); ++i) {
+        auto const payload = "chunk " + std::to_string(i);
+        test_chunks.push_back({
+            .x = chunks[i].first,
+            .z = chunks[i].second,
+            .timestamp = static_cast<std::uint32_t>(1000 + i),
+            .data = {payload.begin(), payload.end()},
+        });
+    }
+    test::write_region_file(path, test_chunks);
+}
+
+std::string decompress_to_string(CompressedChunk chunk) {
+    auto const data = decompress_chunk(chunk);
+    return std::string(data.begin(), data.end());
+}
+
+} // namespace
+
+TEST(RegionFileTest, Chunks) {
+    auto const directory = test::test_directory();
+    std::filesystem::create_directories(directory);
+    write_region_file(directory / "r.0.0.mca", {{0, 0}, {31, 2}});
+    write_region_file(directory / "r.-1.0.mca", {{31, 0}});
+
+    RegionFile region(directory / "r.0.0.mca");
+    auto const first = region.chunk(0, 0);
+    ASSERT_TRUE(first.has_value());
+    EXPECT_EQ(first->compression, ChunkCompression::Zlib);
+    EXPECT_EQ(decompress_to_string(*first), "chunk 0");
+    auto const second = region.chunk(31, 2);
+    ASSERT_TRUE(second.has_value());
+    EXPECT_EQ(decompress_to_string(*second), "chunk 1");
+    EXPECT_EQ(first->timestamp, 1000);
+    EXPECT_EQ(second->timestamp, 1001);
+    EXPECT_FALSE(region.chunk(1, 0).has_value());
+    EXPECT_THROW(region.chunk(32, 0), std::out_of_range);
+
+    RegionDirectory regions(directory);
+    EXPECT_EQ(decompress_to_string(*regions.chunk(31, 2)), "chunk 1");
+    EXPECT_EQ(decompress_to_string(*regions.chunk(-1, 0)), "chunk 0");
+    EXPECT_FALSE(regions.chunk(-2, 0).has_value());
+    EXPECT_FALSE(regions.chunk(100, 100).has_value());
+
+    std::filesystem::remove_all(directory);
+}
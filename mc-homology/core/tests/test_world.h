@@ -0,0 +1,203 @@
+/// \file test_world.h
+/// \brief Writers of synthetic NBT documents, chunks and region files
+///        and temporary directories shared by tests
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include "core/block_states.h"
+#include "core/nbt.h"
+
+namespace core::test {
+
+/// \brief Returns a temporary directory private to the running test
+///
+/// ctest runs tests in parallel, in separate processes, so the path
+/// contains the name of the test and the process id.
+inline std::filesystem::path test_directory() {
+    auto const* info = testing::UnitTest::GetInstance()->current_test_info();
+    return std::filesystem::temp_directory_path()
+        / std::format(
+               "mc_homology_{}_{}_{}",
+               info->test_suite_name(),
+               info->name(),
+               getpid()
+        );
+}
+
+/// \brief A writer of NBT documents
+class NbtWriter {
+public:
+    NbtWriter& begin(NbtTag tag, std::string_view name) {
+        m_data.push_back(static_cast<unsigned char>(tag));
+        return string(name);
+    }
+
+    NbtWriter& integer(std::uint64_t value, std::size_t width) {
+        for (std::size_t i = width; i-- > 0;) {
+            m_data.push_back(static_cast<unsigned char>(value >> (8 * i)));
+        }
+        return *this;
+    }
+
+    NbtWriter& string(std::string_view value) {
+        integer(value.size(), 2);
+        m_data.insert(m_data.end(), value.begin(), value.end());
+        return *this;
+    }
+
+    NbtWriter& list(NbtTag element, std::size_t size) {
+        integer(static_cast<std::uint8_t>(element), 1);
+        return integer(size, 4);
+    }
+
+    NbtWriter& long_array(std::vector<std::uint64_t> const& values) {
+        integer(values.size(), 4);
+        for (auto value : values) {
+            integer(value, 8);
+        }
+        return *this;
+    }
+
+    NbtWriter& end() {
+        m_data.push_back(static_cast<unsigned char>(NbtTag::End));
+        return *this;
+    }
+
+    std::vector<unsigned char> const& data() const {
+        return m_data;
+    }
+
+private:
+    std::vector<unsigned char> m_data;
+};
+
+/// \brief Blocks of a section of a synthetic chunk
+struct TestSection {
+    /// \brief y coordinate of the section, in sections
+    int y = 0;
+    /// \brief Names of palette entries
+    std::vector<std::string> palette;
+    /// \brief Palette indices of blocks in YZX order, empty if the
+    ///        palette has a single entry
+    std::vector<std::uint16_t> indices;
+};
+
+/// \brief Writes NBT data of a chunk in the layout of version 1.18
+///        and newer
+inline std::vector<unsigned char> chunk_nbt(
+    std::vector<TestSection> const& sections,
+    std::int32_t data_version = 3465
+) {
+    NbtWriter writer;
+    writer.begin(NbtTag::Compound, "")
+        .begin(NbtTag::Int, "DataVersion")
+        .integer(static_cast<std::uint32_t>(data_version), 4)
+        .begin(NbtTag::Int, "yPos")
+        .integer(static_cast<std::uint32_t>(-4), 4)
+        .begin(NbtTag::List, "sections")
+        .list(NbtTag::Compound, sections.size());
+    for (auto const& section : sections) {
+        writer.begin(NbtTag::Byte, "Y")
+            .integer(static_cast<std::uint8_t>(section.y), 1)
+            .begin(NbtTag::Compound, "block_states")
+            .begin(NbtTag::List, "palette")
+            .list(NbtTag::Compound, section.palette.size());
+        for (auto const& name : section.palette) {
+            writer.begin(NbtTag::String, "Name").string(name).end();
+        }
+        if (!section.indices.empty()) {
+            // indices never span two longs
+            auto const bits = bits_per_block(section.palette.size());
+            auto const per_word = 64 / bits;
+            std::vector<std::uint64_t> data(
+                (blocks_per_section + per_word - 1) / per_word
+            );
+            for (std::size_t i = 0; i < section.indices.size(); ++i) {
+                data[i / per_word] |= std::uint64_t {section.indices[i]}
+                    << (i % per_word * bits);
+            }
+            writer.begin(NbtTag::LongArray, "data").long_array(data);
+        }
+        writer.end().end();
+    }
+    writer.end();
+    return writer.data();
+}
+
+/// \brief A chunk of a synthetic region file
+struct TestChunk {
+    /// \brief x coordinate of the chunk within the region
+    int x = 0;
+    /// \brief z coordinate of the chunk within the region
+    int z = 0;
+    /// \brief Timestamp of the chunk
+    std::uint32_t timestamp = 0;
+    /// \brief Uncompressed data of the chunk
+    std::vector<unsigned char> data;
+};
+
+/// \brief Writes a region file with zlib-compressed chunks
+inline void write_region_file(
+    std::filesystem::path const& path,
+    std::vector<TestChunk> const& chunks
+) {
+    constexpr std::size_t sector_size = 4096;
+    std::vector<unsigned char> file(2 * sector_size);
+    for (auto const& chunk : chunks) {
+        std::vector<unsigned char> compressed(
+            compressBound(static_cast<uLong>(chunk.data.size()))
+        );
+        auto compressed_size = static_cast<uLongf>(compressed.size());
+        compress(
+            compressed.data(),
+            &compressed_size,
+            chunk.data.data(),
+            static_cast<uLong>(chunk.data.size())
+        );
+        compressed.resize(compressed_size);
+
+        auto const length = static_cast<std::uint32_t>(compressed.size() + 1);
+        std::vector<unsigned char> data = {
+            static_cast<unsigned char>(length >> 24),
+            static_cast<unsigned char>(length >> 16),
+            static_cast<unsigned char>(length >> 8),
+            static_cast<unsigned char>(length),
+            2,
+        };
+        data.insert(data.end(), compressed.begin(), compressed.end());
+        auto const sectors = (data.size() + sector_size - 1) / sector_size;
+        data.resize(sectors * sector_size);
+
+        auto const sector = file.size() / sector_size;
+        auto const location =
+            4 * static_cast<std::size_t>(chunk.x + 32 * chunk.z);
+        file[location] = static_cast<unsigned char>(sector >> 16);
+        file[location + 1] = static_cast<unsigned char>(sector >> 8);
+        file[location + 2] = static_cast<unsigned char>(sector);
+        file[location + 3] = static_cast<unsigned char>(sectors);
+        for (std::size_t i = 0; i < 4; ++i) {
+            file[sector_size + location + i] =
+                static_cast<unsigned char>(chunk.timestamp >> (24 - 8 * i));
+        }
+        file.insert(file.end(), data.begin(), data.end());
+    }
+    std::ofstream output(path, std::ios::binary);
+    output.write(
+        reinterpret_cast<char const*>(file.data()),
+        static_cast<std::streamsize>(file.size())
+    );
+}
+
+} // namespace core::test
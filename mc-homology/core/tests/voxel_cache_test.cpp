@@ -0,0 +1,81 @@
+#include "core/voxel_cache.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+
+#include "test_world.h"
+
+using namespace core;
+
+namespace {
+
+ChunkOccupancy sample_occupancy() {
+    ChunkOccupancy occupancy(2);
+    occupancy[0].y = -4;
+    occupancy[0].blocks[0] = 0b1011;
+    occupancy[1].y = 3;
+    occupancy[1].blocks[63] = ~std::uint64_t {0};
+    return occupancy;
+}
+
+bool equal(ChunkOccupancy const& lhs, ChunkOccupancy const& rhs) {
+    return std::ranges::equal(lhs, rhs, [](auto const& a, auto const& b) {
+        return a.y == b.y && a.blocks == b.blocks;
+    });
+}
+
+} // namespace
+
+TEST(VoxelCacheTest, RoundTrip) {
+    auto const directory = test::test_directory();
+    auto const region_directory = directory / "region";
+    std::filesystem::remove_all(directory);
+    {
+        VoxelCache cache(directory, region_directory, 1);
+        EXPECT_FALSE(cache.find(-1, 5, 100).has_value());
+        cache.insert(-1, 5, 100, sample_occupancy());
+        cache.insert(0, 0, 7, {});
+        cache.flush();
+    }
+    {
+        VoxelCache cache(directory, region_directory, 1);
+        auto const cached = cache.find(-1, 5, 100);
+        ASSERT_TRUE(cached.has_value());
+        EXPECT_TRUE(equal(*cached, sample_occupancy()));
+        EXPECT_TRUE(cache.find(0, 0, 7).has_value());
+        EXPECT_TRUE(cache.find(0, 0, 7)->empty());
+        // stale chunks and other chunks of the region
+        EXPECT_FALSE(cache.find(-1, 5, 101).has_value());
+        EXPECT_FALSE(cache.find(1, 0, 7).has_value());
+        // chunks recorded later are merged with the cached ones
+        cache.insert(1, 0, 8, sample_occupancy());
+        cache.flush();
+    }
+    {
+        VoxelCache cache(directory, region_directory, 1);
+        EXPECT_TRUE(cache.find(0, 0, 7).has_value());
+        EXPECT_TRUE(equal(*cache.find(1, 0, 8), sample_occupancy()));
+        EXPECT_TRUE(equal(*cache.find(-1, 5, 100), sample_occupancy()));
+    }
+    {
+        // another block filter
+        VoxelCache cache(directory, region_directory, 2);
+        EXPECT_FALSE(cache.find(-1, 5, 100).has_value());
+    }
+    {
+        // another dimension with a chunk saved at the same time
+        VoxelCache cache(directory, directory / "DIM-1" / "region", 1);
+        EXPECT_FALSE(cache.find(-1, 5, 100).has_value());
+        cache.insert(-1, 5, 100, {});
+        cache.flush();
+    }
+    {
+        // another spelling of the same directory
+        VoxelCache cache(directory, directory / "." / "region", 1);
+        EXPECT_TRUE(equal(*cache.find(-1, 5, 100), sample_occupancy()));
+    }
+    std::filesystem::remove_all(directory);
+}